@@ -0,0 +1,115 @@
+/**
+ * Arena - a monotonic allocator for objects that live as long as the Store.
+ *
+ * Objects are carved out of large blocks one after another and are never
+ * freed individually. When the arena is released, the destructors of the
+ * objects created in it run newest-first and then the blocks are freed
+ * together, so tearing down millions of movies, customers and tree nodes
+ * costs a handful of free() calls instead of one per object.
+ *
+ * Allocator adapts an arena for standard containers. Memory a container
+ * gives back stays in the arena until it is released; an Allocator without
+ * an arena uses the ordinary heap. An arena must only be used by one
+ * thread at a time.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "Arena.h"
+#include <cstdint>
+#include <cstdlib>
+using namespace std;
+
+/**
+ * Constructs an empty arena. No memory is reserved until the first
+ * allocation.
+ *
+ * @param theBlockSize The size of each block taken from the heap.
+ */
+Arena::Arena(size_t theBlockSize)
+  : next(nullptr), end(nullptr), blockSize(theBlockSize), used(0), reserved(0),
+    cleanups(nullptr) {
+}
+
+/**
+ * Allocates memory from the current block, starting a new block when it
+ * runs out. Requests larger than a quarter of a block get a block of their
+ * own, so they do not waste the rest of the current one.
+ *
+ * @param bytes The number of bytes needed.
+ * @param alignment The alignment needed; a power of two.
+ * @return The allocated memory.
+ */
+void *Arena::allocate(size_t bytes, size_t alignment) {
+  uintptr_t start = (reinterpret_cast<uintptr_t>(next) + alignment - 1) & ~(alignment - 1);
+
+  if(next == nullptr || start + bytes > reinterpret_cast<uintptr_t>(end)) {
+    size_t size = bytes + alignment > blockSize / 4 ? bytes + alignment : blockSize;
+    char *block = static_cast<char*>(malloc(size));
+    if(block == nullptr) {
+      throw bad_alloc();
+    }
+
+    blocks.push_back(block);
+    reserved += size;
+    start = (reinterpret_cast<uintptr_t>(block) + alignment - 1) & ~(alignment - 1);
+
+    // An oversized request leaves the current block in use for later ones.
+    if(size == blockSize) {
+      end = block + size;
+
+    } else {
+        used += bytes;
+        return reinterpret_cast<void*>(start);
+    }
+  }
+
+  next = reinterpret_cast<char*>(start + bytes);
+  used += bytes;
+  return reinterpret_cast<void*>(start);
+}
+
+/**
+ * Destroys every object created in the arena, newest first, and frees all
+ * of its blocks. The arena can be used again afterwards.
+ */
+void Arena::release() {
+  for(Cleanup *cleanup = cleanups; cleanup != nullptr; cleanup = cleanup->previous) {
+    cleanup->destroy(cleanup->object);
+  }
+
+  for(char *block : blocks) {
+    free(block);
+  }
+
+  blocks.clear();
+  cleanups = nullptr;
+  next = end = nullptr;
+  used = reserved = 0;
+}
+
+/**
+ * Returns the number of bytes handed out by the arena.
+ *
+ * @return The bytes allocated since the arena was created or released.
+ */
+size_t Arena::bytesUsed() const {
+  return used;
+}
+
+/**
+ * Returns the number of bytes the arena has taken from the heap.
+ *
+ * @return The total size of the arena's blocks.
+ */
+size_t Arena::bytesReserved() const {
+  return reserved;
+}
+
+/**
+ * Class Destructor
+ */
+Arena::~Arena() {
+  release();
+}
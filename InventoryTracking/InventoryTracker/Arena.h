@@ -0,0 +1,123 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+/**
+ * Arena - a monotonic allocator for objects that live as long as the Store.
+ *
+ * Objects are carved out of large blocks one after another and are never
+ * freed individually. When the arena is released, the destructors of the
+ * objects created in it run newest-first and then the blocks are freed
+ * together, so tearing down millions of movies, customers and tree nodes
+ * costs a handful of free() calls instead of one per object.
+ *
+ * Allocator adapts an arena for standard containers. Memory a container
+ * gives back stays in the arena until it is released; an Allocator without
+ * an arena uses the ordinary heap. An arena must only be used by one
+ * thread at a time.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+using namespace std;
+
+class Arena {
+public:
+  template<typename T>
+  class Allocator {
+  public:
+    typedef T value_type;
+    typedef true_type propagate_on_container_move_assignment;
+    typedef true_type propagate_on_container_swap;
+
+    Allocator(Arena *theArena = nullptr) : arena(theArena) {}
+
+    template<typename U>
+    Allocator(const Allocator<U> &other) : arena(other.getArena()) {}
+
+    T *allocate(size_t count) {
+      if(arena != nullptr) {
+        return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+      }
+
+      return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T *pointer, size_t) {
+      if(arena == nullptr) {
+        ::operator delete(pointer);
+      }
+    }
+
+    Arena *getArena() const { return arena; }
+
+    template<typename U>
+    bool operator==(const Allocator<U> &other) const { return arena == other.getArena(); }
+
+    template<typename U>
+    bool operator!=(const Allocator<U> &other) const { return arena != other.getArena(); }
+
+  private:
+    Arena *arena;
+  };
+
+  static const size_t defaultBlockSize = 1 << 20;
+
+  Arena(size_t blockSize = defaultBlockSize);
+  void *allocate(size_t, size_t);
+  void release();
+  size_t bytesUsed() const;
+  size_t bytesReserved() const;
+
+  /**
+   * Constructs an object in the arena. Its destructor, if it has one that
+   * does anything, runs when the arena is released.
+   *
+   * @param args The arguments for the object's constructor.
+   * @return The new object.
+   */
+  template<typename T, typename... Args>
+  T *create(Args&&... args) {
+    T *object = new(allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+
+    if(!is_trivially_destructible<T>::value) {
+      Cleanup *cleanup = new(allocate(sizeof(Cleanup), alignof(Cleanup))) Cleanup;
+      cleanup->object = object;
+      cleanup->destroy = &destroy<T>;
+      cleanup->previous = cleanups;
+      cleanups = cleanup;
+    }
+
+    return object;
+  }
+
+  ~Arena();
+
+private:
+  struct Cleanup {
+    void *object;
+    void (*destroy)(void *);
+    Cleanup *previous;
+  };
+
+  template<typename T>
+  static void destroy(void *object) { static_cast<T*>(object)->~T(); }
+
+  vector<char*> blocks;
+  char *next;
+  char *end;
+  size_t blockSize;
+  size_t used;
+  size_t reserved;
+  Cleanup *cleanups;
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+};
+#endif // ARENA_H
@@ -16,7 +16,7 @@ using namespace std;
  * Initializes a new instance of the Classic class with default values.
  */
 Classic::Classic()
-  : Movie(), majorActor(""), monthReleased(0) {
+  : Movie(), majorActor(-1), monthReleased(0) {
 }
 
 /**
@@ -24,17 +24,16 @@ Classic::Classic()
  * Initializes a new instance of the Comedy class with specified values.
  *
  * @param type The genre of the movie.
- * @param theStock The number of copies available in stock.
- * @param theTitle The title of the movie.
- * @param theDirector The director of the movie.
- * @param theActor The actor/actress featured in the movie.
+ * @param theDirector The handle of the director's name in the pool.
+ * @param theTitle The handle of the title in the pool.
+ * @param theActor The handle of the actor/actress featured in the movie.
  * @param releaseMonth The month the movie was released.
  * @param theYear The year the movie was released.
+ * @param theNames The pool the handles belong to.
  */
-Classic::Classic(char type, int theStock, const string& theDirector, 
-const string& theTitle, const string& theActor, 
-  int releaseMonth, int theYear)
-  : Movie(type, theStock, theDirector, theTitle, theYear),
+Classic::Classic(char type, int theDirector, int theTitle, 
+  int theActor, int releaseMonth, int theYear, const StringPool *theNames)
+  : Movie(type, theDirector, theTitle, theYear, theNames),
      majorActor(theActor),
     monthReleased(releaseMonth) {
 }
@@ -73,9 +72,9 @@ Classic &Classic::operator=(const Movie &other) {
     const Classic* classicPtr = dynamic_cast<const Classic*>(&other);
     if(classicPtr != nullptr) {
       genre = classicPtr->genre;
-      stock = classicPtr->stock;
       director = classicPtr->director;
       title = classicPtr->title;
+      names = classicPtr->names;
       majorActor = classicPtr->majorActor;
       monthReleased = classicPtr->monthReleased;
       yearReleased = classicPtr->yearReleased;
@@ -92,7 +91,8 @@ Classic &Classic::operator=(const Movie &other) {
  * titles, directors, major actors, and release dates (both month and year).
  * The method ensures that the other Movie object is of type Classic before
  * performing the comparison. If all attributes match, the two Classic movies
- * are considered equal.
+ * are considered equal. The major actor is compared by its handle, so both 
+ * movies must use the same pool.
  *
  * @param other A pointer to the other Movie object to compare with. Expected 
  *              to be of type Classic.
@@ -105,7 +105,7 @@ bool Classic::operator==(const Movie &other) const {
   const Classic *otherClassic = dynamic_cast<const Classic*>(&other);
 
   if(otherClassic != nullptr) {
-    return (getMajorActor() == otherClassic->getMajorActor()
+    return (majorActor == otherClassic->majorActor
       && getMonthReleased() == otherClassic->getMonthReleased()
       && getYearReleased() == otherClassic->getYearReleased());
   }
@@ -188,8 +188,8 @@ bool Classic::operator>(const Movie &other) const {
  * 
  * @return The major actor/actress in this film.
  */
-string Classic::getMajorActor() const {
-  return majorActor;
+const string &Classic::getMajorActor() const {
+  return getName(majorActor);
 }
 
 /**
@@ -201,26 +201,40 @@ int Classic::getMonthReleased() const {
   return monthReleased;
 }
 
+/**
+ * Adds the memory of this Classic to a breakdown. Its names, including the
+ * major actor, are counted with the pool they are interned in.
+ *
+ * @param stats The breakdown to add to.
+ */
+void Classic::accountMemory(MemoryStats &stats) const {
+  stats.add(MemoryStats::MovieRecords, sizeof(Classic));
+}
+
 /**
  * Displays detailed information about this Classic movie.
  * 
  * This function outputs the movie's title, director, actor, 
  * the month and year it was released, formatted for readability. 
  * It provides a clear and concise summary of the movie's key attributes.
+ * 
+ * @param out The writer to format the information into.
+ * @param stockCount The stock count to show, which may have been recorded 
+ *                   earlier than the information is written.
  */
-void Classic::displayInfo() const {
-  if(stock < 0) {
-    cout << "Error: this Movie is out of stock." << endl;
+void Classic::displayInfo(ReportWriter &out, int stockCount) const {
+  if(stockCount < 0) {
+    out.write("Error: this Movie is out of stock.").endLine();
     return;
   }
   
-  cout << left << setw(8) << getGenre()
-       << setw(8) << getStock()
-       << setw(25) << getDirector()
-       << setw(35) << getTitle()
-       << setw(20) << getMajorActor()
-       << setw(8) << getMonthReleased()
-       << getYearReleased() << endl;
+  out.writePadded(genre, 8)
+     .writePadded(stockCount, 8)
+     .writePadded(getDirector(), 25)
+     .writePadded(getTitle(), 35)
+     .writePadded(getMajorActor(), 20)
+     .writePadded(monthReleased, 8)
+     .write(yearReleased).endLine();
 }
 
 /**
@@ -17,16 +17,18 @@ using namespace std;
 
 class Classic : public Movie {
   private:
-    string majorActor;
+    int majorActor;       // handle of the actor's name in the pool
     int monthReleased;
 
   public:
     Classic();
-    Classic(char, int, const string &, const string &, const string &, int, int);
+    Classic(char, int, int, int, int, int, const StringPool *);
     Classic(const Classic &);
     int getMonthReleased() const;
-    string getMajorActor() const;
-    virtual void displayInfo() const override;
+    const string &getMajorActor() const;
+    virtual void accountMemory(MemoryStats &) const override;
+    using Movie::displayInfo;
+    virtual void displayInfo(ReportWriter &, int) const override;
     virtual Classic &operator=(const Movie &) override;
     virtual bool operator==(const Movie &) const override;
     virtual bool operator!=(const Movie &) const override;
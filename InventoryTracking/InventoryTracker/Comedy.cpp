@@ -24,14 +24,14 @@ Comedy::Comedy()
  * Initializes a new instance of the Comedy class with specified values.
  *
  * @param type The genre of the movie.
- * @param theStock The number of copies available in stock.
- * @param theTitle The title of the movie.
- * @param theDirector The director of the movie.
+ * @param theDirector The handle of the director's name in the pool.
+ * @param theTitle The handle of the title in the pool.
  * @param theYear The year the movie was released.
+ * @param theNames The pool the handles belong to.
  */
-Comedy::Comedy(char type, int theStock, const string& theDirector,
-  const string& theTitle, int theYear)
-    : Movie(type, theStock, theDirector, theTitle, theYear) {
+Comedy::Comedy(char type, int theDirector, int theTitle, int theYear,
+  const StringPool *theNames)
+    : Movie(type, theDirector, theTitle, theYear, theNames) {
 }
 
 /**
@@ -64,9 +64,9 @@ Comedy &Comedy::operator=(const Movie &other) {
     const Comedy* comedyPtr = dynamic_cast<const Comedy*>(&other);
     if(comedyPtr != nullptr) {
       genre = comedyPtr->genre;
-      stock = comedyPtr->genre;
       director = comedyPtr->director;
       title = comedyPtr->title;
+      names = comedyPtr->names;
       yearReleased = comedyPtr->yearReleased;
     }
   }
@@ -78,7 +78,8 @@ Comedy &Comedy::operator=(const Movie &other) {
  * Compares this Comedy movie object with another Movie object 
  * to check for equality. The comparison is based on the 
  * title, director, and year released. This method first ensures 
- * that the other Movie object is also of type Comedy.
+ * that the other Movie object is also of type Comedy. Names are 
+ * compared by their handles, so both movies must use the same pool.
  * 
  * @param other A pointer to the other Movie object to compare with.
  * @return true if both Comedy movies have the same title, director, 
@@ -90,8 +91,8 @@ bool Comedy::operator==(const Movie &other) const {
   const Comedy *otherComedy = dynamic_cast<const Comedy *>(&other);
 
   if (otherComedy != nullptr) {
-    return (((getTitle() == otherComedy->getTitle())) 
-      && (getYearReleased() == otherComedy->getYearReleased()));
+    return title == otherComedy->title 
+      && getYearReleased() == otherComedy->getYearReleased();
   }
 
   return false;
@@ -152,16 +153,30 @@ bool Comedy::operator>(const Movie &other) const {
   return !(*this < other) && (*this != other);
 }
 
+/**
+ * Adds the memory of this Comedy to a breakdown. Its names are counted
+ * with the pool they are interned in.
+ *
+ * @param stats The breakdown to add to.
+ */
+void Comedy::accountMemory(MemoryStats &stats) const {
+  stats.add(MemoryStats::MovieRecords, sizeof(Comedy));
+}
+
 /**
  * Displays detailed information about this Comedy movie.
  * 
  * This function outputs the movie's title, director, 
  * and the year it was released, formatted for readability. 
  * It provides a clear and concise summary of the movie's key attributes.
+ * 
+ * @param out The writer to format the information into.
+ * @param stockCount The stock count to show, which may have been recorded 
+ *                   earlier than the information is written.
  */
-void Comedy::displayInfo() const {
-  if(stock < 0) {
-    cout << "Error: this Movie is out of stock." << endl;
+void Comedy::displayInfo(ReportWriter &out, int stockCount) const {
+  if(stockCount < 0) {
+    out.write("Error: this Movie is out of stock.").endLine();
     return;
   }
 
@@ -171,14 +186,12 @@ void Comedy::displayInfo() const {
   const int titleWidth = 40;       // Width for the title
   const int yearWidth = 4;         // Width for the year
 
-  // Set the output format
-  cout << left
-       << setw(genreWidth) << getGenre() << " " 
-       << setw(stockWidth) << getStock() << " "
-       << setw(directorWidth) << getDirector() << " "
-       << setw(titleWidth) << getTitle() << " "
-       << setw(yearWidth) << getYearReleased()
-       << endl;
+  out.writePadded(genre, genreWidth).write(' ')
+     .writePadded(stockCount, stockWidth).write(' ')
+     .writePadded(getDirector(), directorWidth).write(' ')
+     .writePadded(getTitle(), titleWidth).write(' ')
+     .writePadded(yearReleased, yearWidth)
+     .endLine();
 }
 
 /**
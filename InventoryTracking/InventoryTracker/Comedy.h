@@ -17,9 +17,11 @@ using namespace std;
 class Comedy : public Movie {
 public:
   Comedy();
-  Comedy(char, int, const string &, const string &, int);
+  Comedy(char, int, int, int, const StringPool *);
   Comedy(const Comedy &);
-  virtual void displayInfo() const override;
+  virtual void accountMemory(MemoryStats &) const override;
+  using Movie::displayInfo;
+  virtual void displayInfo(ReportWriter &, int) const override;
   virtual Comedy &operator=(const Movie &) override;
   virtual bool operator==(const Movie &) const override;
   virtual bool operator!=(const Movie &) const override;
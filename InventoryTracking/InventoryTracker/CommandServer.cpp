@@ -0,0 +1,736 @@
+/**
+ * CommandServer - serves store commands to clients over a socket.
+ *
+ * The server keeps one Store loaded and accepts connections on a Unix domain
+ * socket or a localhost TCP port. Clients send commands in the same syntax 
+ * as the command file, one per line (`B 1000 D F ...`, `H 8888`, `I`). Each 
+ * command is executed as soon as its line is complete, and its reply is 
+ * everything the command printed followed by a line containing only ".".
+ * 
+ * Clients may pipeline: send many commands without waiting for replies. 
+ * Every complete line received is executed in one batch, in order, with 
+ * the replies written straight into the connection's output buffer, so a 
+ * batch's replies go back to the client in as few large writes as the 
+ * socket allows. Inventory reports are not copied into the buffer: the 
+ * Store's cached reports are queued as shared segments ahead of it and 
+ * sent from where they are with scatter-gather writes.
+ * 
+ * All connections are handled by one thread with an epoll event loop and 
+ * non-blocking sockets, so thousands of idle or slow clients cost only 
+ * their buffers. Commands from all clients are executed one at a time, in 
+ * the order their lines arrive. The server runs until it receives SIGINT 
+ * or SIGTERM.
+ * 
+ * History reports are slow to print compared to a borrow or return, so 
+ * they run on a separate, lower-priority report lane: the event loop 
+ * records the report's state when its command is reached and carries on 
+ * with other commands while the report lane renders it. A connection's
+ * replies still go out in command order; replies to commands that follow 
+ * an unfinished report wait behind it.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "CommandServer.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+using namespace std;
+
+namespace {
+  // Longest request line accepted, and the amount of unsent replies at 
+  // which a connection stops reading until its client catches up.
+  const size_t maxLineLength = 1 << 20;
+  const size_t maxPendingOutput = 4 << 20;
+  const size_t maxQueuedReplies = 512;
+
+  // Most pieces of output gathered into one write.
+  const size_t maxSegmentsPerWrite = 64;
+
+  // Niceness of the report lane's thread; higher runs at lower priority.
+  const int reportNiceness = 10;
+
+  // The eventfd that the signal handler wakes the running server through.
+  int signalEvent = -1;
+
+  void requestStop(int) {
+    uint64_t one = 1;
+    ssize_t result = write(signalEvent, &one, sizeof(one));
+    (void) result;
+  }
+}
+
+/**
+ * Constructs a server for the given Store. The Store must already be 
+ * loaded and must outlive the server.
+ *
+ * @param commandStore The Store that executes the clients' commands.
+ */
+CommandServer::CommandServer(Store &commandStore)
+  : store(commandStore), listenSocket(-1), epollDescriptor(-1), stopEvent(-1),
+    reportEvent(-1), commandsServed(0), connectionsAccepted(0), reportsDeferred(0),
+    nextSerial(0), reportLane(1) {
+  reportLane.submit([] {
+    setpriority(PRIO_PROCESS, gettid(), reportNiceness);
+  });
+}
+
+/**
+ * Starts listening for connections.
+ *
+ * An address containing a '/' is the path of a Unix domain socket, which is
+ * created (replacing a stale socket left at that path). Any other address 
+ * is a TCP port, optionally preceded by a numeric host and ':'; the host 
+ * defaults to 127.0.0.1.
+ *
+ * @param address The socket path or [host:]port to listen on.
+ * @return true if the server is listening; false if the socket could not 
+ *         be set up, after printing an error message.
+ */
+bool CommandServer::listen(const string &address) {
+  // Each client needs a descriptor, so allow as many as the system permits.
+  rlimit limit;
+  if(getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+
+  bool bound = false;
+
+  if(address.find('/') != string::npos) {
+    sockaddr_un local = {};
+    local.sun_family = AF_UNIX;
+
+    if(address.size() >= sizeof(local.sun_path)) {
+      cout << "Error: socket path " << address << " is too long." << endl;
+      return false;
+    }
+
+    struct stat existing;
+    if(stat(address.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+      unlink(address.c_str());
+    }
+
+    strcpy(local.sun_path, address.c_str());
+    listenSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    bound = listenSocket >= 0 
+      && bind(listenSocket, reinterpret_cast<sockaddr*>(&local), sizeof(local)) == 0;
+
+    if(bound) {
+      socketPath = address;
+    }
+
+  } else {
+      size_t colon = address.rfind(':');
+      string host = colon == string::npos ? "127.0.0.1" : address.substr(0, colon);
+      string port = colon == string::npos ? address : address.substr(colon + 1);
+      sockaddr_in local = {};
+      local.sin_family = AF_INET;
+      local.sin_port = htons(static_cast<uint16_t>(atoi(port.c_str())));
+
+      if(inet_pton(AF_INET, host.c_str(), &local.sin_addr) != 1 || atoi(port.c_str()) <= 0) {
+        cout << "Error: invalid address " << address << "." << endl;
+        return false;
+      }
+
+      listenSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+      int reuse = 1;
+      bound = listenSocket >= 0
+        && setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) == 0
+        && bind(listenSocket, reinterpret_cast<sockaddr*>(&local), sizeof(local)) == 0;
+  }
+
+  if(!bound || ::listen(listenSocket, SOMAXCONN) != 0) {
+    cout << "Error: cannot listen on " << address << ": " << strerror(errno) << "." << endl;
+    return false;
+  }
+
+  epollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+  stopEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  reportEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = listenSocket;
+  bool registered = epollDescriptor >= 0 && stopEvent >= 0 && reportEvent >= 0
+    && epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, listenSocket, &event) == 0;
+  event.data.fd = stopEvent;
+  registered = registered && epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, stopEvent, &event) == 0;
+  event.data.fd = reportEvent;
+  registered = registered && epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, reportEvent, &event) == 0;
+
+  if(!registered) {
+    cout << "Error: cannot set up event loop: " << strerror(errno) << "." << endl;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Runs the event loop: accepts connections, executes the commands clients
+ * send and writes back their replies, until SIGINT or SIGTERM is received.
+ * The number of commands served is reported when the loop stops.
+ *
+ * @return true if the server stopped on a signal; false if the event loop 
+ *         failed.
+ */
+bool CommandServer::run() {
+  struct sigaction stop = {}, previousInterrupt, previousTerminate;
+  stop.sa_handler = requestStop;
+  sigemptyset(&stop.sa_mask);
+  signalEvent = stopEvent;
+  sigaction(SIGINT, &stop, &previousInterrupt);
+  sigaction(SIGTERM, &stop, &previousTerminate);
+
+  const int maxEvents = 256;
+  epoll_event events[maxEvents];
+  bool stopping = false, failed = false;
+
+  while(!stopping && !failed) {
+    int ready = epoll_wait(epollDescriptor, events, maxEvents, -1);
+
+    if(ready < 0) {
+      if(errno != EINTR) {
+        cout << "Error: event loop failed: " << strerror(errno) << "." << endl;
+        failed = true;
+      }
+
+      continue;
+    }
+
+    for(int i = 0; i < ready; i++) {
+      int descriptor = events[i].data.fd;
+
+      if(descriptor == listenSocket) {
+        acceptConnections();
+        continue;
+      }
+
+      if(descriptor == stopEvent) {
+        stopping = true;
+        continue;
+      }
+
+      if(descriptor == reportEvent) {
+        finishReports();
+        continue;
+      }
+
+      auto found = connections.find(descriptor);
+      if(found == connections.end()) {
+        continue;
+      }
+
+      Connection &connection = found->second;
+      bool open = true;
+
+      if(events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+        open = readRequests(descriptor, connection);
+      }
+
+      if(open && flush(descriptor, connection)) {
+        updateEvents(descriptor, connection);
+
+      } else {
+          closeConnection(descriptor);
+      }
+    }
+  }
+
+  sigaction(SIGINT, &previousInterrupt, nullptr);
+  sigaction(SIGTERM, &previousTerminate, nullptr);
+  signalEvent = -1;
+
+  cout << "Served " << commandsServed << " commands on " << connectionsAccepted 
+       << " connections; " << reportsDeferred << " reports ran on the report lane." << endl;
+  return !failed;
+}
+
+/**
+ * Accepts every pending connection and registers it with the event loop.
+ */
+void CommandServer::acceptConnections() {
+  while(true) {
+    int descriptor = accept4(listenSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    if(descriptor < 0) {
+      if(errno == EMFILE || errno == ENFILE) {
+        cout << "Error: too many connections: " << strerror(errno) << "." << endl;
+      }
+
+      return;
+    }
+
+    // Replies are small; send them without waiting to fill a segment.
+    int noDelay = 1;
+    setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = descriptor;
+
+    if(epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, descriptor, &event) != 0) {
+      close(descriptor);
+      continue;
+    }
+
+    Connection &connection = connections[descriptor];
+    connection.events = EPOLLIN;
+    connection.serial = ++nextSerial;
+    connectionsAccepted++;
+  }
+}
+
+/**
+ * Reads everything a client has sent and executes each complete command 
+ * line as one batch, appending its reply, everything the command printed 
+ * followed by a "." line, to the connection's output. Stops executing 
+ * once the unsent output grows too large, leaving the remaining lines to 
+ * be executed once the client has caught up. A line longer than the 
+ * server accepts is answered with an error reply, after which the rest 
+ * of the client's input is read and dropped until it closes its end.
+ *
+ * @param descriptor The connection's socket.
+ * @param connection The connection's state.
+ * @return false if the connection failed and should be closed; true 
+ *         otherwise.
+ */
+bool CommandServer::readRequests(int descriptor, Connection &connection) {
+  char buffer[65536];
+
+  while(connection.reading && !connection.finished 
+    && (connection.discarding || connection.input.size() < maxLineLength)) {
+    ssize_t received = recv(descriptor, buffer, sizeof(buffer), 0);
+
+    if(received > 0) {
+      if(!connection.discarding) {
+        connection.input.append(buffer, received);
+      }
+
+      continue;
+    }
+
+    if(received == 0) {
+      connection.finished = true;
+
+    } else if(errno == EINTR) {
+        continue;
+
+    } else if(errno != EAGAIN && errno != EWOULDBLOCK) {
+        return false;
+    }
+
+    break;
+  }
+
+  size_t lineStart = 0, lineEnd;
+  streambuf *originalOutput = cout.rdbuf(&replies);
+  streambuf *originalErrors = cerr.rdbuf(&replies);
+  Log::Capture errors(cout);
+
+  while(pendingOutput(connection) < maxPendingOutput
+    && connection.queued.size() < maxQueuedReplies
+    && (lineEnd = connection.input.find('\n', lineStart)) != string::npos) {
+    size_t length = lineEnd - lineStart;
+
+    if(length > 0 && connection.input[lineEnd - 1] == '\r') {
+      length--;
+    }
+
+    if(length > 0) {
+      request.assign(connection.input, lineStart, length);
+      function<void(ostream &)> report;
+      replies.setTarget(&replyTarget(connection));
+      store.executeCommand(request, report, inventoryReports);
+
+      if(report) {
+        deferReport(descriptor, connection, move(report));
+
+      } else if(!inventoryReports.empty() && !connection.queued.empty()) {
+          shared_ptr<Reply> reply = make_shared<Reply>();
+          reply->reports.swap(inventoryReports);
+          connection.queued.push_back(reply);
+          reply->text += ".\n";
+
+      } else {
+          for(shared_ptr<const string> &text : inventoryReports) {
+            queueSegment(connection, move(text));
+          }
+
+          replyTarget(connection) += ".\n";
+      }
+
+      commandsServed++;
+    }
+
+    lineStart = lineEnd + 1;
+  }
+
+  cout.rdbuf(originalOutput);
+  cerr.rdbuf(originalErrors);
+
+  connection.input.erase(0, lineStart);
+
+  if(connection.input.size() >= maxLineLength && connection.input.find('\n') == string::npos) {
+    replyTarget(connection) += "Error: command line longer than " + to_string(maxLineLength) 
+      + " bytes.\n.\n";
+    connection.input.clear();
+    connection.discarding = true;
+  }
+
+  connection.reading = pendingOutput(connection) < maxPendingOutput
+    && connection.queued.size() < maxQueuedReplies;
+  return true;
+}
+
+/**
+ * Returns the string that the next reply on a connection should be 
+ * appended to: the output itself, unless replies are waiting behind an 
+ * unfinished report, in which case the last waiting reply.
+ *
+ * @param connection The connection being replied to.
+ * @return The string to append the reply to.
+ */
+string &CommandServer::replyTarget(Connection &connection) {
+  if(connection.queued.empty()) {
+    return connection.output;
+  }
+
+  if(connection.queued.back()->deferred) {
+    connection.queued.push_back(make_shared<Reply>());
+  }
+
+  return connection.queued.back()->text;
+}
+
+/**
+ * Queues a report to be rendered on the report lane. Its reply takes its 
+ * place in the connection's reply order now, and is released once the 
+ * report lane has rendered it.
+ *
+ * @param descriptor The connection's socket.
+ * @param connection The connection the report command arrived on.
+ * @param report Writes the report, from state recorded by the Store.
+ */
+void CommandServer::deferReport(int descriptor, Connection &connection,
+  function<void(ostream &)> report) {
+  shared_ptr<Reply> reply = make_shared<Reply>();
+  reply->deferred = true;
+  connection.queued.push_back(reply);
+  unsigned long long serial = connection.serial;
+  reportsDeferred++;
+
+  reportLane.submit([this, reply, report, descriptor, serial] {
+    ReplyBuffer buffer;
+    buffer.setTarget(&reply->text);
+    ostream out(&buffer);
+    report(out);
+    out << ".\n";
+    reply->rendered = true;
+
+    {
+      lock_guard<mutex> lock(reportLock);
+      renderedReports.emplace_back(descriptor, serial);
+    }
+
+    uint64_t one = 1;
+    ssize_t result = write(reportEvent, &one, sizeof(one));
+    (void) result;
+  });
+}
+
+/**
+ * Moves every reply at the front of a connection's queue that is ready to
+ * send, up to the first unfinished report, to the connection's output. 
+ * The replies' text is moved, not copied.
+ *
+ * @param connection The connection whose replies to release.
+ */
+void CommandServer::releaseReplies(Connection &connection) {
+  while(!connection.queued.empty() 
+    && (!connection.queued.front()->deferred || connection.queued.front()->rendered)) {
+    Reply &reply = *connection.queued.front();
+
+    for(shared_ptr<const string> &text : reply.reports) {
+      queueSegment(connection, move(text));
+    }
+
+    queueText(connection, reply.text);
+    connection.queued.pop_front();
+  }
+}
+
+/**
+ * Appends a piece of text to a connection's output without copying it. 
+ * The replies already in the output buffer become a segment of their own 
+ * ahead of it.
+ *
+ * @param connection The connection to send the text on.
+ * @param text The text to send; it must not change until it is sent.
+ */
+void CommandServer::queueSegment(Connection &connection, shared_ptr<const string> text) {
+  if(text->empty()) {
+    return;
+  }
+
+  if(!connection.output.empty()) {
+    connection.segmentBytes += connection.output.size();
+    connection.segments.push_back(make_shared<const string>(move(connection.output)));
+    connection.output.clear();
+  }
+
+  connection.segmentBytes += text->size();
+  connection.segments.push_back(move(text));
+}
+
+/**
+ * Appends a reply's text to a connection's output, moving it rather than 
+ * copying it.
+ *
+ * @param connection The connection to send the text on.
+ * @param text The text to send; it is left empty.
+ */
+void CommandServer::queueText(Connection &connection, string &text) {
+  if(connection.segments.empty() && connection.output.empty()) {
+    connection.output.swap(text);
+
+  } else if(!text.empty()) {
+      queueSegment(connection, make_shared<const string>(move(text)));
+      text.clear();
+  }
+}
+
+/**
+ * Returns the number of bytes of output a connection has not sent yet.
+ *
+ * @param connection The connection's state.
+ * @return The unsent bytes of its segments and output buffer.
+ */
+size_t CommandServer::pendingOutput(const Connection &connection) {
+  return connection.segmentBytes + connection.output.size() - connection.written;
+}
+
+/**
+ * Releases the replies behind every report the report lane has finished 
+ * since the last call, and sends them.
+ */
+void CommandServer::finishReports() {
+  uint64_t count;
+  ssize_t result = read(reportEvent, &count, sizeof(count));
+  (void) result;
+
+  vector<pair<int, unsigned long long>> finished;
+
+  {
+    lock_guard<mutex> lock(reportLock);
+    finished.swap(renderedReports);
+  }
+
+  for(const pair<int, unsigned long long> &report : finished) {
+    auto found = connections.find(report.first);
+
+    // The client may have disconnected while its report was rendered.
+    if(found == connections.end() || found->second.serial != report.second) {
+      continue;
+    }
+
+    releaseReplies(found->second);
+
+    if(flush(report.first, found->second)) {
+      updateEvents(report.first, found->second);
+
+    } else {
+        closeConnection(report.first);
+    }
+  }
+}
+
+/**
+ * Sends as much of a connection's pending output as the socket accepts. 
+ * The segments and the output buffer are gathered into each write in 
+ * order, straight from where they are.
+ *
+ * @param descriptor The connection's socket.
+ * @param connection The connection's state.
+ * @return false if the connection failed, or if the client has closed its
+ *         end and every reply, including unfinished reports, has been 
+ *         sent; true otherwise.
+ */
+bool CommandServer::flush(int descriptor, Connection &connection) {
+  while(pendingOutput(connection) > 0) {
+    iovec parts[maxSegmentsPerWrite];
+    size_t count = 0, offset = connection.written;
+
+    for(const shared_ptr<const string> &segment : connection.segments) {
+      if(count == maxSegmentsPerWrite) {
+        break;
+      }
+
+      parts[count].iov_base = const_cast<char*>(segment->data() + offset);
+      parts[count++].iov_len = segment->size() - offset;
+      offset = 0;
+    }
+
+    if(count < maxSegmentsPerWrite && connection.output.size() > offset) {
+      parts[count].iov_base = &connection.output[offset];
+      parts[count++].iov_len = connection.output.size() - offset;
+    }
+
+    msghdr message = {};
+    message.msg_iov = parts;
+    message.msg_iovlen = count;
+    ssize_t sent = sendmsg(descriptor, &message, MSG_NOSIGNAL);
+
+    if(sent >= 0) {
+      connection.written += sent;
+
+      while(!connection.segments.empty() 
+        && connection.written >= connection.segments.front()->size()) {
+        connection.written -= connection.segments.front()->size();
+        connection.segmentBytes -= connection.segments.front()->size();
+        connection.segments.pop_front();
+      }
+
+    } else if(errno == EAGAIN || errno == EWOULDBLOCK) {
+        return true;
+
+    } else if(errno != EINTR) {
+        return false;
+    }
+  }
+
+  connection.output.clear();
+  connection.written = 0;
+  connection.reading = true;
+
+  // After an over-long line, tell the client its last reply has been sent.
+  if(connection.discarding && connection.queued.empty()) {
+    shutdown(descriptor, SHUT_WR);
+  }
+
+  // Lines held back while output was pending can run now.
+  if(connection.queued.size() < maxQueuedReplies && connection.input.find('\n') != string::npos) {
+    return readRequests(descriptor, connection) && flush(descriptor, connection);
+  }
+
+  return !connection.finished || !connection.queued.empty();
+}
+
+/**
+ * Registers the events a connection is waiting for: readable while it 
+ * accepts more commands, and writable while it has output to send.
+ *
+ * @param descriptor The connection's socket.
+ * @param connection The connection's state.
+ */
+void CommandServer::updateEvents(int descriptor, Connection &connection) {
+  uint32_t wanted = 0;
+
+  if(connection.reading && !connection.finished) {
+    wanted |= EPOLLIN;
+  }
+
+  if(pendingOutput(connection) > 0) {
+    wanted |= EPOLLOUT;
+  }
+
+  if(wanted != connection.events) {
+    epoll_event event = {};
+    event.events = wanted;
+    event.data.fd = descriptor;
+    epoll_ctl(epollDescriptor, EPOLL_CTL_MOD, descriptor, &event);
+    connection.events = wanted;
+  }
+}
+
+/**
+ * Closes a connection and forgets its state.
+ *
+ * @param descriptor The connection's socket.
+ */
+void CommandServer::closeConnection(int descriptor) {
+  epoll_ctl(epollDescriptor, EPOLL_CTL_DEL, descriptor, nullptr);
+  close(descriptor);
+  connections.erase(descriptor);
+}
+
+/**
+ * Constructs a stream buffer with no target; output is discarded until a
+ * target is set.
+ */
+CommandServer::ReplyBuffer::ReplyBuffer() : target(nullptr) {
+}
+
+/**
+ * Sets the string that output is appended to.
+ *
+ * @param output The string to append to.
+ */
+void CommandServer::ReplyBuffer::setTarget(string *output) {
+  target = output;
+}
+
+/**
+ * Appends one character to the target.
+ *
+ * @param character The character to append.
+ * @return The character, as `streambuf` requires.
+ */
+int CommandServer::ReplyBuffer::overflow(int character) {
+  if(character != traits_type::eof() && target != nullptr) {
+    target->push_back(static_cast<char>(character));
+  }
+
+  return traits_type::not_eof(character);
+}
+
+/**
+ * Appends a run of characters to the target.
+ *
+ * @param characters The characters to append.
+ * @param count The number of characters.
+ * @return The number of characters written.
+ */
+streamsize CommandServer::ReplyBuffer::xsputn(const char *characters, streamsize count) {
+  if(target != nullptr) {
+    target->append(characters, count);
+  }
+
+  return count;
+}
+
+/**
+ * Class Destructor
+ */
+CommandServer::~CommandServer() {
+  reportLane.wait();
+
+  for(auto &connection : connections) {
+    close(connection.first);
+  }
+
+  for(int descriptor : {listenSocket, epollDescriptor, stopEvent, reportEvent}) {
+    if(descriptor >= 0) {
+      close(descriptor);
+    }
+  }
+
+  if(!socketPath.empty()) {
+    unlink(socketPath.c_str());
+  }
+}
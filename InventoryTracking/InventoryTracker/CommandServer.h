@@ -0,0 +1,123 @@
+#ifndef COMMANDSERVER_H
+#define COMMANDSERVER_H
+
+/**
+ * CommandServer - serves store commands to clients over a socket.
+ *
+ * The server keeps one Store loaded and accepts connections on a Unix domain
+ * socket or a localhost TCP port. Clients send commands in the same syntax 
+ * as the command file, one per line (`B 1000 D F ...`, `H 8888`, `I`). Each 
+ * command is executed as soon as its line is complete, and its reply is 
+ * everything the command printed followed by a line containing only ".".
+ * 
+ * Clients may pipeline: send many commands without waiting for replies. 
+ * Every complete line received is executed in one batch, in order, with 
+ * the replies written straight into the connection's output buffer, so a 
+ * batch's replies go back to the client in as few large writes as the 
+ * socket allows. Inventory reports are not copied into the buffer: the 
+ * Store's cached reports are queued as shared segments ahead of it and 
+ * sent from where they are with scatter-gather writes.
+ * 
+ * All connections are handled by one thread with an epoll event loop and 
+ * non-blocking sockets, so thousands of idle or slow clients cost only 
+ * their buffers. Commands from all clients are executed one at a time, in 
+ * the order their lines arrive. The server runs until it receives SIGINT 
+ * or SIGTERM.
+ * 
+ * History reports are slow to print compared to a borrow or return, so 
+ * they run on a separate, lower-priority report lane: the event loop 
+ * records the report's state when its command is reached and carries on 
+ * with other commands while the report lane renders it. A connection's
+ * replies still go out in command order; replies to commands that follow 
+ * an unfinished report wait behind it.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "Store.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+using namespace std;
+
+class CommandServer {
+public:
+  CommandServer(Store &);
+  bool listen(const string &);
+  bool run();
+  ~CommandServer();
+
+private:
+  class ReplyBuffer : public streambuf {
+  public:
+    ReplyBuffer();
+    void setTarget(string *);
+
+  protected:
+    int overflow(int) override;
+    streamsize xsputn(const char *, streamsize) override;
+
+  private:
+    string *target;
+  };
+
+  struct Reply {
+    vector<shared_ptr<const string>> reports;   // rendered reports to send before `text`
+    string text;                     // the reply, or replies, to send
+    bool deferred = false;           // true for a report rendered on the report lane
+    atomic<bool> rendered{false};    // set once a deferred report's text is complete
+  };
+
+  struct Connection {
+    string input;              // bytes received but not yet a complete line
+    deque<shared_ptr<const string>> segments;   // output to send before `output`
+    size_t segmentBytes = 0;   // the total size of `segments`
+    string output;             // replies not yet sent, after the segments
+    size_t written = 0;        // bytes of the first segment, or of `output`, already sent
+    bool reading = true;       // false while reading is paused for backpressure
+    bool finished = false;     // true once the client has closed its end
+    bool discarding = false;   // true after an over-long line; input is dropped
+    unsigned events = 0;       // the epoll events currently registered
+    unsigned long long serial = 0;     // tells connections reusing a socket apart
+    deque<shared_ptr<Reply>> queued;   // replies waiting behind an unfinished report
+  };
+
+  Store &store;
+  int listenSocket;
+  int epollDescriptor;
+  int stopEvent;
+  int reportEvent;
+  string socketPath;
+  unordered_map<int, Connection> connections;
+  ReplyBuffer replies;
+  string request;
+  vector<shared_ptr<const string>> inventoryReports;
+  long long commandsServed;
+  long long connectionsAccepted;
+  long long reportsDeferred;
+  unsigned long long nextSerial;
+  mutex reportLock;
+  vector<pair<int, unsigned long long>> renderedReports;
+  ThreadPool reportLane;
+
+  void acceptConnections();
+  bool readRequests(int, Connection &);
+  string &replyTarget(Connection &);
+  void deferReport(int, Connection &, function<void(ostream &)>);
+  void releaseReplies(Connection &);
+  void queueSegment(Connection &, shared_ptr<const string>);
+  void queueText(Connection &, string &);
+  static size_t pendingOutput(const Connection &);
+  void finishReports();
+  bool flush(int, Connection &);
+  void updateEvents(int, Connection &);
+  void closeConnection(int);
+};
+#endif // COMMANDSERVER_H
@@ -0,0 +1,224 @@
+/**
+ * CommandStats - counts and latencies of the commands a Store executes, by
+ * transaction type and, for borrows and returns, by genre.
+ *
+ * Every command executed on its own is counted, and its latency recorded 
+ * in a LatencyHistogram for its type and genre. Reading the clock costs 
+ * about as much as a tenth of a borrow, so only every sixteenth borrow or 
+ * return of each type and genre is timed, which keeps the percentiles 
+ * close while adding well under a percent. Histories, inventories and 
+ * stats do far more work than a clock read, so every one is timed. The 
+ * failures are the Log's counts of the matching messages, which are kept 
+ * anyway. The parallel engines apply borrows and returns in batches, so 
+ * their commands are neither counted nor timed here.
+ *
+ * The command server renders history reports after taking their 
+ * snapshot, in command order, so for those commands only the snapshot is
+ * timed; they are counted as deferred and the table says so.
+ *
+ * A CommandStats is updated by one thread at a time: the one executing 
+ * the Store's commands.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "CommandStats.h"
+#include "Log.h"
+using namespace std;
+
+/**
+ * Starts executing a command: counts it and, unless it is a borrow or 
+ * return not due to be sampled, starts timing it.
+ *
+ * @param theStats The statistics to add the command to.
+ * @param type The command's transaction type.
+ * @param genre The genre of the movie it names, for borrows and returns.
+ * @param deferred Whether the command's report is rendered after this 
+ *                 Sample ends, so only its snapshot is timed.
+ */
+CommandStats::Sample::Sample(CommandStats &theStats, char type, char genre, bool deferred)
+  : stats(theStats), row(rowOf(type, genre)), timed(true) {
+  stats.counts[row]++;
+  stats.deferred += deferred;
+
+  if(isSampled(row)) {
+    timed = --stats.untilSample[row] == 0;
+    if(timed) {
+      stats.untilSample[row] = sampleInterval;
+    }
+  }
+
+  if(timed) {
+    started = chrono::steady_clock::now();
+  }
+}
+
+/**
+ * Class Destructor
+ * Records the command's latency, if it was timed.
+ */
+CommandStats::Sample::~Sample() {
+  if(timed) {
+    stats.latencies[row].record(chrono::duration_cast<chrono::nanoseconds>(
+      chrono::steady_clock::now() - started).count());
+  }
+}
+
+/**
+ * Class constructor
+ */
+CommandStats::CommandStats() : deferred(0), latencies(rows) {
+  for(int i = 0; i < rows; i++) {
+    counts[i] = 0;
+    untilSample[i] = 1;
+  }
+}
+
+/**
+ * Displays a table of the commands executed and their sampled latency 
+ * percentiles, a row per transaction type followed by a row per genre for
+ * borrows and returns, then the failures logged so far. Unknown genre 
+ * codes are rejected when a command is parsed; unknown genres in the movie
+ * file are counted on their own row.
+ *
+ * @param out The writer to display the table with.
+ */
+void CommandStats::display(ReportWriter &out) const {
+  out.write("Command Latency (every ").write(to_string(sampleInterval))
+    .write("th borrow and return of each genre timed, other commands all timed): ").endLine();
+
+  if(deferred > 0) {
+    out.write(to_string(deferred)).write(" history commands from the server ")
+      .write("are timed to their snapshot, not their rendered report.").endLine();
+  }
+
+  out.write("-----------------------------------------------------").endLine();
+  out.writePadded("Command", 10).writePadded("Count", 12).writePadded("Timed", 10)
+    .writePadded("p50 ns", 10).writePadded("p99 ns", 10).writePadded("p999 ns", 10)
+    .write("Max ns").endLine();
+
+  for(int first = 0; first < rows; first += first < 2 * genres ? genres : 1) {
+    int last = first < 2 * genres ? first + genres : first + 1;
+    long long count = 0;
+    LatencyHistogram latency;
+
+    for(int i = first; i < last; i++) {
+      count += counts[i];
+      latency.merge(latencies[i]);
+    }
+
+    if(count == 0) {
+      continue;
+    }
+
+    displayRow(out, getName(first).substr(0, 1), count, latency);
+
+    for(int i = first; i < last && last - first > 1; i++) {
+      if(counts[i] > 0) {
+        displayRow(out, "  " + getName(i), counts[i], latencies[i]);
+      }
+    }
+  }
+
+  out.write("Failures: ").endLine();
+  out.writePadded("Customer not found", 22)
+    .write(to_string(Log::count(Log::CustomerNotFound))).endLine();
+  out.writePadded("Movie not found", 22)
+    .write(to_string(Log::count(Log::MovieNotFound))).endLine();
+  out.writePadded("Out of stock", 22)
+    .write(to_string(Log::count(Log::OutOfStock))).endLine();
+  out.writePadded("Unknown genre code", 22)
+    .write(to_string(Log::count(Log::UnknownGenreCode))).endLine();
+  out.writePadded("Unknown genre in file", 22)
+    .write(to_string(Log::count(Log::UnknownGenre))).endLine();
+}
+
+/**
+ * Adds the memory of the latency histograms to a breakdown.
+ *
+ * @param stats The breakdown to add to.
+ */
+void CommandStats::accountMemory(MemoryStats &stats) const {
+  for(const LatencyHistogram &latency : latencies) {
+    latency.accountMemory(stats, MemoryStats::CommandLatencies);
+  }
+}
+
+/**
+ * Returns the row a command is counted in.
+ *
+ * @param type The command's transaction type.
+ * @param genre The genre of the movie it names, for borrows and returns.
+ * @return The row's index.
+ */
+int CommandStats::rowOf(char type, char genre) {
+  switch(type) {
+    case 'B':
+    case 'R': {
+      int column = genre == 'C' ? 0 : genre == 'D' ? 1 : genre == 'F' ? 2 : 3;
+      return (type == 'B' ? 0 : genres) + column;
+    }
+
+    case 'H':
+      return 2 * genres;
+
+    case 'I':
+      return 2 * genres + 1;
+
+    case 'S':
+      return 2 * genres + 2;
+
+    default:
+      return 2 * genres + 3;
+  }
+}
+
+/**
+ * Reports whether a row's commands are sampled rather than all timed: 
+ * borrows and returns, which are too quick to time every one.
+ *
+ * @param row The row's index.
+ * @return true if only every sampleInterval-th command of the row is timed.
+ */
+bool CommandStats::isSampled(int row) {
+  return row < 2 * genres;
+}
+
+/**
+ * Returns the name a row is displayed with: its transaction type, then the
+ * genre for borrows and returns.
+ *
+ * @param row The row's index.
+ * @return Its name.
+ */
+string CommandStats::getName(int row) {
+  const char *names[rows] = {
+    "B C", "B D", "B F", "B ?", "R C", "R D", "R F", "R ?", "H", "I", "S", "?"
+  };
+
+  return names[row];
+}
+
+/**
+ * Displays one row of the latency table.
+ *
+ * @param out The writer to display the row with.
+ * @param name The row's name.
+ * @param count The number of commands executed.
+ * @param latency The latencies of those that were timed.
+ */
+void CommandStats::displayRow(ReportWriter &out, const string &name, long long count,
+  const LatencyHistogram &latency) {
+  out.writePadded(name, 10).writePadded(to_string(count), 12)
+    .writePadded(to_string(latency.count()), 10)
+    .writePadded(to_string(latency.percentile(50)), 10)
+    .writePadded(to_string(latency.percentile(99)), 10)
+    .writePadded(to_string(latency.percentile(99.9)), 10)
+    .write(to_string(latency.max())).endLine();
+}
+
+/**
+ * Class Destructor
+ */
+CommandStats::~CommandStats() {}
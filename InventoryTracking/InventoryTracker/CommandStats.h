@@ -0,0 +1,74 @@
+#ifndef COMMANDSTATS_H
+#define COMMANDSTATS_H
+
+/**
+ * CommandStats - counts and latencies of the commands a Store executes, by
+ * transaction type and, for borrows and returns, by genre.
+ *
+ * Every command executed on its own is counted, and its latency recorded 
+ * in a LatencyHistogram for its type and genre. Reading the clock costs 
+ * about as much as a tenth of a borrow, so only every sixteenth borrow or 
+ * return of each type and genre is timed, which keeps the percentiles 
+ * close while adding well under a percent. Histories, inventories and 
+ * stats do far more work than a clock read, so every one is timed. The 
+ * failures are the Log's counts of the matching messages, which are kept 
+ * anyway. The parallel engines apply borrows and returns in batches, so 
+ * their commands are neither counted nor timed here.
+ *
+ * The command server renders history reports after taking their 
+ * snapshot, in command order, so for those commands only the snapshot is
+ * timed; they are counted as deferred and the table says so.
+ *
+ * A CommandStats is updated by one thread at a time: the one executing 
+ * the Store's commands.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "LatencyHistogram.h"
+#include "MemoryStats.h"
+#include "ReportWriter.h"
+#include <chrono>
+#include <string>
+#include <vector>
+using namespace std;
+
+class CommandStats {
+public:
+  static const int sampleInterval = 16;
+
+  class Sample {
+  public:
+    Sample(CommandStats &, char, char, bool deferred = false);
+    ~Sample();
+
+  private:
+    CommandStats &stats;
+    int row;
+    bool timed;
+    chrono::steady_clock::time_point started;
+  };
+
+  CommandStats();
+  void display(ReportWriter &) const;
+  void accountMemory(MemoryStats &) const;
+  ~CommandStats();
+
+private:
+  // Borrows and returns of each genre and of an unknown genre, then
+  // histories, inventories, stats and unknown types.
+  static const int genres = 4;
+  static const int rows = 2 * genres + 4;
+
+  long long counts[rows];
+  long long untilSample[rows];
+  long long deferred;           // histories timed to their snapshot
+  vector<LatencyHistogram> latencies;
+
+  static int rowOf(char, char);
+  static bool isSampled(int);
+  static string getName(int);
+  static void displayRow(ReportWriter &, const string &, long long, const LatencyHistogram &);
+};
+#endif // COMMANDSTATS_H
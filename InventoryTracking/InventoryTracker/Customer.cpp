@@ -7,6 +7,9 @@
  * Functionality may be expanded in the future to include additional attributes and methods, 
  * such as contact information, rental history, or loyalty status.
  * 
+ * The rental history is kept as compact entries that refer to the interned
+ * title of the movie borrowed or returned instead of holding their own text.
+ * 
  * Nolan Dela Rosa
  * 
  * August 12, 2024
@@ -47,34 +50,49 @@ Customer::Customer(int customerID, const string &first, const string &last)
  * Adds a transaction record to the customer's list of transactions.
  * 
  * This method appends a new transaction entry to the `transactions` vector for the current customer.
- * The transaction string could represent various customer activities, such as borrowing or returning movies.
+ * The entry records what the customer did, such as borrowing or returning a movie, and which movie.
  * 
- * @param transaction A string describing the transaction to be recorded. This might include details such as the type of transaction (e.g., borrowing), movie title, and date.
+ * @param transaction The entry describing the transaction to be recorded.
  */
-void Customer::addTransaction(const string &transaction) {
+void Customer::addTransaction(const HistoryEntry &transaction) {
   transactions.push_back(transaction);
 }
 
 /**
  * Retrieves the transaction history for the Customer.
  * 
- * This method returns a vector of strings, where each string
- * represents a transaction performed by the Customer. The transactions
- * are stored in the order they were performed, with the earliest 
- * transaction at the beginning of the vector and the most recent 
- * transaction at the end.
+ * This method returns the entries for the transactions performed by 
+ * the Customer. The transactions are stored in the order they were 
+ * performed, with the earliest transaction at the beginning of the 
+ * vector and the most recent transaction at the end.
  *
- * @return A vector containing the Customer's transaction history.
+ * @return The Customer's transaction history.
  */
-vector<string> Customer::displayHistory() const {
+const vector<Customer::HistoryEntry> &Customer::displayHistory() const {
   return transactions;
 }
 
+/**
+ * Adds the memory of this customer's record, name and history to a 
+ * breakdown.
+ *
+ * @param stats The breakdown to add to.
+ */
+void Customer::accountMemory(MemoryStats &stats) const {
+  stats.add(MemoryStats::CustomerRecords, sizeof(Customer) 
+    + MemoryStats::heapBytes(firstName) + MemoryStats::heapBytes(lastName));
+
+  stats.add(MemoryStats::HistoryEntries, transactions.capacity() * sizeof(HistoryEntry), 
+    transactions.size());
+}
+
 /**
  * Displays the customer's name and ID.
+ *
+ * @param out The stream to write the name to.
  */
-void Customer::displayInfo() const {
-  cout << lastName << " " << firstName;
+void Customer::displayInfo(ostream &out) const {
+  out << lastName << " " << firstName;
 }
 
 /**
@@ -86,6 +104,28 @@ int Customer::getID() const {
   return ID;
 }
 
+/**
+ * Writes a history entry as it is shown in the customer's history, such 
+ * as "Borrowed Casablanca".
+ *
+ * @param out The stream to write the entry to.
+ */
+void Customer::HistoryEntry::displayInfo(ostream &out) const {
+  switch(action) {
+    case Borrowed:
+      out << "Borrowed " << *title;
+      break;
+
+    case Returned:
+      out << "Returned " << *title;
+      break;
+
+    default:
+      out << "Viewed History";
+      break;
+  }
+}
+
 /**
  * Class Destructor
  */
@@ -10,6 +10,9 @@
  * Functionality may be expanded in the future to include additional attributes and methods, 
  * such as contact information, rental history, or loyalty status.
  * 
+ * The rental history is kept as compact entries that refer to the interned
+ * title of the movie borrowed or returned instead of holding their own text.
+ * 
  * Nolan Dela Rosa
  * 
  * August 12, 2024
@@ -17,22 +20,37 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include "MemoryStats.h"
 using namespace std;
 
 class Customer {
+public:
+  struct HistoryEntry {
+    enum Action {Borrowed, Returned, ViewedHistory};
+
+    Action action = ViewedHistory;
+    const string *title = nullptr;    // the interned title of the movie, if any
+
+    HistoryEntry() = default;
+    HistoryEntry(Action theAction, const string *theTitle = nullptr)
+      : action(theAction), title(theTitle) {}
+    void displayInfo(ostream &) const;
+  };
+
 private:
   int ID;
   string firstName;
   string lastName;
-  vector<string> transactions;
+  vector<HistoryEntry> transactions;
 
 public:
   Customer();
   Customer(int, const string &, const string &);
-  void displayInfo() const;
-  void addTransaction(const string &);
+  void displayInfo(ostream &out = cout) const;
+  void addTransaction(const HistoryEntry &);
   int getID() const;
-  vector<string> displayHistory() const;
+  const vector<HistoryEntry> &displayHistory() const;
+  void accountMemory(MemoryStats &) const;
   ~Customer();  
 };
 #endif // CUSTOMER_H
\ No newline at end of file
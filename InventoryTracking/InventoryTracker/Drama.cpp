@@ -24,14 +24,14 @@ Drama::Drama()
  * Initializes a new instance of the Drama class with specified values.
  *
  * @param type The genre of the movi.
- * @param theStock The number of copies available in stock.
- * @param theTitle The title of the movie.
- * @param theDirector The director of the movie.
+ * @param theDirector The handle of the director's name in the pool.
+ * @param theTitle The handle of the title in the pool.
  * @param theYear The year the movie was released.
+ * @param theNames The pool the handles belong to.
  */
-Drama::Drama(char type, int theStock, const string& theDirector,
-  const string& theTitle, int theYear)
-    : Movie(type, theStock, theDirector, theTitle, theYear) {
+Drama::Drama(char type, int theDirector, int theTitle, int theYear,
+  const StringPool *theNames)
+    : Movie(type, theDirector, theTitle, theYear, theNames) {
 }
 
 
@@ -66,9 +66,9 @@ Drama &Drama::operator=(const Movie &other) {
     const Drama* dramaPtr = dynamic_cast<const Drama*>(&other);
     if(dramaPtr != nullptr) {
       genre = dramaPtr->genre;
-      stock = dramaPtr->genre;
       director = dramaPtr->director;
       title = dramaPtr->title;
+      names = dramaPtr->names;
       yearReleased = dramaPtr->yearReleased;
     }
   }
@@ -81,7 +81,8 @@ Drama &Drama::operator=(const Movie &other) {
  * Compares this Drama movie object with another Movie object 
  * to check for equality. The comparison is based on the 
  * title, director, and year released. This method first ensures 
- * that the other Movie object is also of type Drama.
+ * that the other Movie object is also of type Drama. Names are 
+ * compared by their handles, so both movies must use the same pool.
  * 
  * @param other A pointer to the other Movie object to compare with.
  * @return true if both Drama movies have the same title, director, 
@@ -92,8 +93,7 @@ bool Drama::operator==(const Movie &other) const {
   const Drama *otherDrama = dynamic_cast<const Drama *>(&other);
 
   if (otherDrama != nullptr) {
-    return (((getTitle() == otherDrama->getTitle()) 
-      && (getDirector() == otherDrama->getDirector())));
+    return title == otherDrama->title && director == otherDrama->director;
   }
 
   return false;
@@ -157,16 +157,30 @@ bool Drama::operator>(const Movie &other) const {
   return !(*this < other) && (*this != other);
 }
 
+/**
+ * Adds the memory of this Drama to a breakdown. Its names are counted
+ * with the pool they are interned in.
+ *
+ * @param stats The breakdown to add to.
+ */
+void Drama::accountMemory(MemoryStats &stats) const {
+  stats.add(MemoryStats::MovieRecords, sizeof(Drama));
+}
+
 /**
  * Displays detailed information about this Drama movie.
  * 
  * This function outputs the movie's title, director, 
  * and the year it was released, formatted for readability. 
  * It provides a clear and concise summary of the movie's key attributes.
+ * 
+ * @param out The writer to format the information into.
+ * @param stockCount The stock count to show, which may have been recorded 
+ *                   earlier than the information is written.
  */
-void Drama::displayInfo() const {
-  if(stock < 0) {
-    cout << "Error: this Movie is out of stock." << endl;
+void Drama::displayInfo(ReportWriter &out, int stockCount) const {
+  if(stockCount < 0) {
+    out.write("Error: this Movie is out of stock.").endLine();
     return;
   }
 
@@ -176,14 +190,12 @@ void Drama::displayInfo() const {
   const int titleWidth = 40;       // Width for the title
   const int yearWidth = 4;         // Width for the year
 
-  // Set the output format
-  cout << left
-       << setw(genreWidth) << getGenre() << " " 
-       << setw(stockWidth) << getStock() << " "
-       << setw(directorWidth) << getDirector() << " "
-       << setw(titleWidth) << getTitle() << " "
-       << setw(yearWidth) << getYearReleased()
-       << endl;
+  out.writePadded(genre, genreWidth).write(' ')
+     .writePadded(stockCount, stockWidth).write(' ')
+     .writePadded(getDirector(), directorWidth).write(' ')
+     .writePadded(getTitle(), titleWidth).write(' ')
+     .writePadded(yearReleased, yearWidth)
+     .endLine();
 }
 
 /**
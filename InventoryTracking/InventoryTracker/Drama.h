@@ -17,9 +17,11 @@ using namespace std;
 class Drama : public Movie {
 public:
   Drama();
-  Drama(char, int, const string &, const string &, int);
+  Drama(char, int, int, int, const StringPool *);
   Drama(const Drama &);
-  virtual void displayInfo() const override;
+  virtual void accountMemory(MemoryStats &) const override;
+  using Movie::displayInfo;
+  virtual void displayInfo(ReportWriter &, int) const override;
   virtual Drama &operator=(const Movie &) override;
   virtual bool operator==(const Movie &) const override;
   virtual bool operator!=(const Movie &) const override;
@@ -0,0 +1,225 @@
+/**
+ * FileFollower - a class that follows a growing text file, like `tail -f`.
+ *
+ * The follower remembers how far into the file it has read and only ever
+ * reads the bytes appended since the last call, handing back complete lines.
+ * A trailing line without its newline is buffered until the rest of it is
+ * written. Changes are detected with inotify when the kernel supports it and
+ * by periodically checking the file size otherwise. If the file is truncated
+ * the follower starts over from its beginning.
+ *
+ * Each line is handed back with the time the follower first saw it 
+ * complete in the file, taken as it wakes for the change, so callers can 
+ * measure how long an appended line waited. A single read is capped at a few MiB,
+ * so catching up with a large backlog never holds it all in memory at once.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "FileFollower.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <thread>
+using namespace std;
+
+/**
+ * Constructs a follower for the given file. The file is not opened until
+ * `open` is called.
+ *
+ * @param name The path of the file to follow.
+ * @param interval How often, in milliseconds, to check the file for growth 
+ *                 when inotify is unavailable.
+ */
+FileFollower::FileFollower(const string &name, int interval)
+  : fileName(name), pollInterval(interval), fileDescriptor(-1),
+    inotifyDescriptor(-1), offset(0), backlogSize(0), seenSize(0), pending("") {
+}
+
+/**
+ * Opens the followed file and, if possible, registers an inotify watch on it.
+ * When inotify cannot be initialized the follower silently falls back to 
+ * polling the file size.
+ *
+ * @return true if the file was opened; false otherwise.
+ */
+bool FileFollower::open() {
+  fileDescriptor = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if(fileDescriptor < 0) {
+    return false;
+  }
+
+  struct stat status;
+
+  if(fstat(fileDescriptor, &status) == 0) {
+    backlogSize = status.st_size;
+    seenSize = backlogSize;
+  }
+
+  inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+  if(inotifyDescriptor >= 0 && inotify_add_watch(inotifyDescriptor, fileName.c_str(),
+    IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB) < 0) {
+    close(inotifyDescriptor);
+    inotifyDescriptor = -1;
+  }
+
+  return true;
+}
+
+/**
+ * Waits up to the given time for complete lines to be appended to the file
+ * and returns them. Bytes already in the file when this is called are 
+ * returned immediately without waiting.
+ *
+ * @param lines Receives the complete lines read, without their newlines.
+ * @param arrivals Receives, for each line, when the follower first saw it 
+ *                 complete in the file; a default time_point for a line 
+ *                 that was already in the file when it was opened.
+ * @param timeout The longest time to wait, in milliseconds.
+ * @return true if at least one complete line was read; false on timeout.
+ */
+bool FileFollower::waitForLines(vector<string> &lines, 
+  vector<chrono::steady_clock::time_point> &arrivals, int timeout) {
+  if(readAppended(lines, arrivals)) {
+    return true;
+  }
+
+  auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeout);
+
+  while(chrono::steady_clock::now() < deadline) {
+    int remaining = static_cast<int>(chrono::duration_cast<chrono::milliseconds>(
+      deadline - chrono::steady_clock::now()).count());
+    waitForChange(remaining > 0 ? remaining : 0);
+
+    if(readAppended(lines, arrivals)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Blocks until the file may have changed or the timeout expires. With inotify
+ * this sleeps on the watch descriptor and drains its pending events; without
+ * it, this simply sleeps for one poll interval.
+ *
+ * @param timeout The longest time to wait, in milliseconds.
+ */
+void FileFollower::waitForChange(int timeout) {
+  if(inotifyDescriptor < 0) {
+    this_thread::sleep_for(chrono::milliseconds(min(timeout, pollInterval)));
+    return;
+  }
+
+  pollfd watch = {inotifyDescriptor, POLLIN, 0};
+
+  if(poll(&watch, 1, timeout) > 0) {
+    char events[4096];
+    while(read(inotifyDescriptor, events, sizeof(events)) > 0) {
+    }
+  }
+}
+
+/**
+ * Reads the bytes appended since the previous read, up to `maxReadSize` of
+ * them, and splits the complete lines off the front of the buffered data. 
+ * A trailing partial line stays buffered. If the file has shrunk below the
+ * current offset it is assumed to have been truncated and is read again 
+ * from the start. Growth is timestamped when it is first noticed, so bytes 
+ * left for a later read keep the time they arrived.
+ *
+ * @param lines Receives the complete lines read, without their newlines.
+ * @param arrivals Receives when each line was first seen complete.
+ * @return true if at least one complete line was read; false otherwise.
+ */
+bool FileFollower::readAppended(vector<string> &lines, 
+  vector<chrono::steady_clock::time_point> &arrivals) {
+  struct stat status;
+
+  if(fstat(fileDescriptor, &status) != 0 || status.st_size == offset) {
+    return false;
+  }
+
+  if(status.st_size < offset) {
+    offset = 0;
+    backlogSize = 0;
+    seenSize = 0;
+    pending.clear();
+    growth.clear();
+  }
+
+  if(status.st_size > seenSize) {
+    seenSize = status.st_size;
+    growth.emplace_back(seenSize, chrono::steady_clock::now());
+  }
+
+  long long end = min<long long>(status.st_size, offset + maxReadSize);
+  long long pendingStart = offset - pending.size();
+  char buffer[65536];
+  ssize_t bytesRead = 0;
+
+  while(offset < end && (bytesRead = pread(fileDescriptor, buffer, 
+    min<long long>(sizeof(buffer), end - offset), offset)) > 0) {
+    pending.append(buffer, bytesRead);
+    offset += bytesRead;
+  }
+
+  size_t start = 0;
+  size_t newline = 0;
+  size_t count = lines.size();
+
+  while((newline = pending.find('\n', start)) != string::npos) {
+    long long lineEnd = pendingStart + newline + 1;
+
+    while(!growth.empty() && growth.front().first < lineEnd) {
+      growth.pop_front();
+    }
+
+    lines.push_back(pending.substr(start, newline - start));
+    arrivals.push_back(lineEnd <= backlogSize || growth.empty() 
+      ? chrono::steady_clock::time_point() : growth.front().second);
+    start = newline + 1;
+  }
+
+  pending.erase(0, start);
+  return lines.size() > count;
+}
+
+/**
+ * Reports whether changes are detected through inotify rather than polling.
+ *
+ * @return true if an inotify watch is active; false if polling.
+ */
+bool FileFollower::isUsingInotify() const {
+  return inotifyDescriptor >= 0;
+}
+
+/**
+ * Reports whether some of the bytes that were already in the file when it 
+ * was opened have not been read yet.
+ *
+ * @return true while the follower is still catching up with the file's 
+ *         original contents; false once only appended bytes remain.
+ */
+bool FileFollower::hasBacklog() const {
+  return offset < backlogSize;
+}
+
+/**
+ * Class Destructor
+ */
+FileFollower::~FileFollower() {
+  if(inotifyDescriptor >= 0) {
+    close(inotifyDescriptor);
+  }
+
+  if(fileDescriptor >= 0) {
+    close(fileDescriptor);
+  }
+}
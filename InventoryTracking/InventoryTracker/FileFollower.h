@@ -0,0 +1,56 @@
+#ifndef FILEFOLLOWER_H
+#define FILEFOLLOWER_H
+
+/**
+ * FileFollower - a class that follows a growing text file, like `tail -f`.
+ *
+ * The follower remembers how far into the file it has read and only ever
+ * reads the bytes appended since the last call, handing back complete lines.
+ * A trailing line without its newline is buffered until the rest of it is
+ * written. Changes are detected with inotify when the kernel supports it and
+ * by periodically checking the file size otherwise. If the file is truncated
+ * the follower starts over from its beginning.
+ *
+ * Each line is handed back with the time the follower first saw it 
+ * complete in the file, taken as it wakes for the change, so callers can 
+ * measure how long an appended line waited. A single read is capped at a few MiB,
+ * so catching up with a large backlog never holds it all in memory at once.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include <chrono>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+class FileFollower {
+public:
+  FileFollower(const string &, int pollInterval = 50);
+  bool open();
+  bool waitForLines(vector<string> &, vector<chrono::steady_clock::time_point> &, int);
+  bool isUsingInotify() const;
+  bool hasBacklog() const;
+  ~FileFollower();
+
+private:
+  static const long long maxReadSize = 4 << 20;
+
+  string fileName;
+  int pollInterval;
+  int fileDescriptor;
+  int inotifyDescriptor;
+  long long offset;
+  long long backlogSize;
+  long long seenSize;     // the file size when it was last checked
+  string pending;
+  // The file's size at each check that found it grown, and when that was.
+  deque<pair<long long, chrono::steady_clock::time_point>> growth;
+
+  bool readAppended(vector<string> &, vector<chrono::steady_clock::time_point> &);
+  void waitForChange(int);
+};
+#endif // FILEFOLLOWER_H
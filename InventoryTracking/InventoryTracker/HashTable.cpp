@@ -18,10 +18,18 @@ using namespace std;
  * with each list designed to handle collisions via separate chaining.
  * 
  * @param size The size of the hash table, determining the number of buckets (lists).
+ * @param theArena The arena the table's list nodes are allocated in, or 
+ *                 nullptr to use the heap. A table with an arena does not 
+ *                 delete its customers; the arena destroys them when it is 
+ *                 released, so they must be created in the same arena.
  */
-HashTable::HashTable(int size)
-  : tableSize(size) {
-  table = new list<Customer*>[tableSize];
+HashTable::HashTable(int size, Arena *theArena)
+  : tableSize(size), arena(theArena) {
+  table = new Bucket[tableSize];
+
+  for(int i = 0; i < tableSize; i++) {
+    table[i] = Bucket(Arena::Allocator<Customer*>(arena));
+  }
 }
 
 /**
@@ -54,7 +62,10 @@ void HashTable::insert(Customer* customer) {
 
     for (auto &existingCustomer : list) {
         if (existingCustomer->getID() == customer->getID()) {
-            delete existingCustomer;  // Delete the old customer object
+            if (arena == nullptr) {
+                delete existingCustomer;  // Delete the old customer object
+            }
+
             existingCustomer = customer;  // Replace with the new one
             return;
         }
@@ -117,6 +128,24 @@ Customer* HashTable::get(int customerID) const {
   return nullptr;
 }
 
+/**
+ * Adds the memory of the table, its list nodes and its customers to a 
+ * breakdown. Each list node holds a customer pointer and two links.
+ *
+ * @param stats The breakdown to add to.
+ */
+void HashTable::accountMemory(MemoryStats &stats) const {
+  stats.add(MemoryStats::CustomerTable, tableSize * sizeof(Bucket), 0);
+
+  for(int i = 0; i < tableSize; i++) {
+    stats.add(MemoryStats::CustomerTable, table[i].size() * 3 * sizeof(void*), table[i].size());
+
+    for(const Customer *customer : table[i]) {
+      customer->accountMemory(stats);
+    }
+  }
+}
+
 /**
  * Clears all entries from the hash table.
  * 
@@ -128,8 +157,10 @@ Customer* HashTable::get(int customerID) const {
  */
 void HashTable::clear() {
   for(int i = 0; i < tableSize; ++i) {
-    for(auto customer : table[i]) {
-      delete customer; // Delete all customer objects in each list
+    if(arena == nullptr) {
+      for(auto customer : table[i]) {
+        delete customer; // Delete all customer objects in each list
+      }
     }
 
     table[i].clear();
@@ -13,20 +13,25 @@
  */
 #include <list>
 #include "Customer.h"
+#include "Arena.h"
 using namespace std;
 
 class HashTable {
 public:
-  HashTable(int size = 101);
+  HashTable(int size = 101, Arena *theArena = nullptr);
   void clear();
   void insert(Customer*);
   bool remove(int);
   Customer* get(int) const;
+  void accountMemory(MemoryStats &) const;
   ~HashTable();
 
 private:
+  typedef list<Customer*, Arena::Allocator<Customer*>> Bucket;
+
   int tableSize;
-  list<Customer*>* table;
+  Arena *arena;
+  Bucket* table;
   int hash(int) const;
 };
 
@@ -15,72 +15,72 @@
 using namespace std;
 
 /**
- * Default constructor for the History class.
- * 
- * Initializes a History object with default values. The transaction type is set to
- * the default value of the base Transaction class, and the customerID is initialized
- * to 0, indicating that no specific customer has been associated with this transaction yet.
+ * Executes the History transaction to display the customer's transaction history.
+ *
+ * This function uses the customer the Transaction was resolved to when it was prepared. 
+ * If the customer is found, it retrieves their transaction history.
+ * If the customer does not exist, an error message is displayed. If the customer exists but has no recorded transactions,
+ * a message indicating that there are no recorded transactions is displayed. Otherwise, the function 
+ * iterates through the customer's transaction history and prints each transaction.
+ *
+ * @param transaction The prepared history Transaction naming the customer to display.
  */
-History::History()
-  : Transaction() {
+void History::execute(const Transaction &transaction) {
+  render(snapshot(transaction), cout);
 }
 
 /**
- * Parameterized constructor for the History class.
- * 
- * This constructor initializes a History object with specific values for the transaction type 
- * and customer ID. The `trans` parameter is passed to the base Transaction class to define 
- * the type of transaction (e.g., borrow, return), while the `ID` parameter is used to 
- * associate this transaction with a specific customer.
+ * Records the customer's transaction history as of this transaction. If 
+ * there is a history to view, viewing it is recorded in the history 
+ * straight away, after the copy, so the record is kept in transaction 
+ * order even when the snapshot is rendered later.
  *
- * @param trans A character representing the type of transaction (e.g., 'B' for borrow).
- * @param ID An integer representing the unique customer ID for whom the transaction is being recorded.
+ * @param transaction The prepared history Transaction naming the customer.
+ * @return The customer, or nullptr if not found, and a copy of their history.
  */
-History::History(char trans, char genreType, int ID)
-  : Transaction(trans, genreType, ID) {
+History::Snapshot History::snapshot(const Transaction &transaction) {
+  Customer* currentCustomer = transaction.getCustomer();
+  Snapshot recorded;
+  recorded.customer = currentCustomer;
+
+  if(currentCustomer != nullptr) {
+    recorded.entries = currentCustomer->displayHistory();
+
+    if(!recorded.entries.empty()) {
+      currentCustomer->addTransaction(Customer::HistoryEntry::ViewedHistory);
+    }
+  }
+
+  return recorded;
 }
 
 /**
- * Executes the History transaction to display the customer's transaction history.
- *
- * This function retrieves the customer associated with the `customerID` stored in the History object 
- * from the provided HashTable of customers. If the customer is found, it retrieves their transaction history.
- * If the customer does not exist, an error message is displayed. If the customer exists but has no recorded transactions,
- * a message indicating that there are no recorded transactions is displayed. Otherwise, the function 
- * iterates through the customer's transaction history and prints each transaction.
+ * Displays a recorded transaction history exactly as `execute` would have 
+ * displayed it when the snapshot was taken.
  *
- * @param movies A reference to the MovieTree, though it is not used in this method.
- * @param customers A reference to the HashTable containing customer data.
+ * @param recorded The customer and history recorded by `snapshot`.
+ * @param out The stream to write the history to.
  */
-void History::execute(MovieTree &movies, HashTable &customers) {
-  Customer* currentCustomer = customers.get(customerID);
-
-  if(currentCustomer == nullptr) {
-    cout << "Error: customer not found!" << endl;
+void History::render(const Snapshot &recorded, ostream &out) {
+  if(recorded.customer == nullptr) {
+    out << "Error: customer not found!" << endl;
     return;
   }
 
-  vector<string> customerTransactions = currentCustomer->displayHistory();
-
-  if(customerTransactions.empty()) {
-    cout << "No recorded transactions for this customer." << endl;
+  if(recorded.entries.empty()) {
+    out << "No recorded transactions for this customer." << endl;
     return;
   }
 
-  cout << "Transaction History for ";
-  currentCustomer->displayInfo();
-  currentCustomer->addTransaction("Viewed History");
-  cout << endl;
-  cout << "--------------------------------------------------------------" << endl;
+  out << "Transaction History for ";
+  recorded.customer->displayInfo(out);
+  out << endl;
+  out << "--------------------------------------------------------------" << endl;
   
-  for(const string &transaction : customerTransactions) {
-    cout << transaction << endl;
+  for(const Customer::HistoryEntry &entry : recorded.entries) {
+    entry.displayInfo(out);
+    out << endl;
   }
 
-  cout << endl;
+  out << endl;
 }
-
-/**
- * Class Destructor
- */
-History::~History() {}
\ No newline at end of file
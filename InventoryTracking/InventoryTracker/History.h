@@ -10,23 +10,26 @@
  * This class helps maintain an organized record of customer activities, 
  * ensuring that their transaction history can be easily accessed and reviewed when needed.
  *
+ * Like an inventory report, a history can be split into a `snapshot` taken 
+ * when the transaction is reached and a `render` step that prints it later.
+ *
  * Nolan Dela Rosa
  * 
  * August 13, 2024
  */
 #include "Transaction.h"
-#include "HashTable.h"
 #include "Customer.h"
 using namespace std;
 
-class MovieTree;
-
-class History : public Transaction {
-
+class History {
 public:
-  History();
-  History(char, char, int);
-  virtual void execute(MovieTree &, HashTable &) override;
-  virtual ~History();
+  struct Snapshot {
+    const Customer *customer = nullptr;       // nullptr if the customer was not found
+    vector<Customer::HistoryEntry> entries;   // the history before it was viewed
+  };
+
+  static void execute(const Transaction &);
+  static Snapshot snapshot(const Transaction &);
+  static void render(const Snapshot &, ostream &);
 };
-#endif // HISTORY_H
\ No newline at end of file
+#endif // HISTORY_H
@@ -2,26 +2,26 @@
 #define INVENTORY_H
 
 /**
- * InventoryTransaction - a class to represent a transaction for displaying the current inventory of movies.
+ * Inventory - a class to execute transactions for displaying the current inventory of movies.
  * This class is used to generate and display a report of all movies currently available in the MovieTree.
- * It inherits from the Transaction class and implements the execute method to print out detailed
- * information about each movie in the inventory, including their titles and other relevant details.
+ * Its execute method prints out detailed information about each movie in the inventory, 
+ * including their titles and other relevant details.
+ * 
+ * A report can also be printed from an InventoryCache, which keeps the 
+ * rendered report of a tree up to date as stock changes instead of 
+ * formatting every movie again.
  * 
  * Nolan Dela Rosa
  * 
  * August 13, 2024
  */
-#include "Transaction.h"
 #include "MovieTree.h"
+#include "InventoryCache.h"
 using namespace std;
 
-class HashTable;
-
-class Inventory : public Transaction {
+class Inventory {
 public:
-  Inventory();
-  Inventory(char, char, int);
-  virtual void execute(MovieTree &, HashTable &) override;
-  virtual ~Inventory();
+  static void execute(const MovieTree &);
+  static void execute(const string &);
 };
 #endif // INVENTORY
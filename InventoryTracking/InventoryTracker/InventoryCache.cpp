@@ -0,0 +1,272 @@
+/**
+ * InventoryCache - a pre-rendered inventory report for one genre's movies,
+ * kept up to date row by row.
+ *
+ * The first report renders every movie of the MovieTree into one string, 
+ * remembering where each movie's row starts. Each movie is then watched: 
+ * when `StockTable::changed` reports that its stock changed, its row is 
+ * added to a list of stale rows. The next report re-renders only the rows
+ * on that list, in place when the row keeps its length, so reporting an 
+ * inventory costs time in proportion to the rows that changed. A movie's 
+ * row only changes length when its stock goes negative or outgrows its 
+ * column; the rest of the report is then moved once for all such rows.
+ * 
+ * The report is double-buffered: a caller may keep a report it was given 
+ * while the cache moves on. The cache keeps the previous report as a 
+ * spare and, once no caller holds it, brings it up to date and hands it 
+ * out next. The text is only copied when a caller still holds both.
+ *
+ * Rendering from scratch is split into chunks of consecutive rows, 
+ * which are rendered concurrently on a thread pool into separate buffers 
+ * and then joined in order.
+ *
+ * Rows may be marked stale from several threads at once, as long as each 
+ * movie is only updated by one thread at a time; `refresh` must not run 
+ * concurrently with stock updates.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "InventoryCache.h"
+#include "ReportWriter.h"
+#include <algorithm>
+#include <cstring>
+using namespace std;
+
+namespace {
+  // Rows rendered by one task when the report is rendered from scratch.
+  const size_t rowsPerChunk = 8192;
+}
+
+/**
+ * Class constructor
+ */
+InventoryCache::InventoryCache() : dirtyCount(0), spareReflowed(false), built(false) {
+}
+
+/**
+ * Returns the inventory report for a MovieTree, exactly as 
+ * `Inventory::execute` prints it, bringing the cached rows up to date first.
+ *
+ * @param tree The genre's MovieTree; the same tree on every call until 
+ *             the cache is reset.
+ * @param pool The thread pool to render the report on.
+ * @return The current report. It does not change after being returned.
+ */
+shared_ptr<const string> InventoryCache::refresh(const MovieTree &tree, ThreadPool &pool) {
+  if(!built) {
+    rebuild(tree, pool);
+
+  } else if(dirtyCount.load(memory_order_relaxed) > 0) {
+      updateStaleRows();
+  }
+
+  return report;
+}
+
+/**
+ * Marks a row as stale because its movie's stock changed, adding it to 
+ * the list of rows to re-render unless it is on the list already.
+ *
+ * @param row The row of the movie, as given to `Movie::watchStock`.
+ */
+void InventoryCache::invalidate(size_t row) {
+  if(stale[row]) {
+    return;
+  }
+
+  stale[row] = 1;
+  dirty[dirtyCount.fetch_add(1, memory_order_relaxed)] = row;
+}
+
+/**
+ * Discards the cached report and stops watching the movies, so the next 
+ * report is rendered from scratch. Must be called whenever movies are 
+ * added to or removed from the tree.
+ */
+void InventoryCache::reset() {
+  for(const Movie *movie : movies) {
+    movie->watchStock(nullptr, 0);
+  }
+
+  movies.clear();
+  offsets.clear();
+  stale.clear();
+  dirty.clear();
+  dirtyCount = 0;
+  report.reset();
+  spare.reset();
+  spareDirty.clear();
+  spareReflowed = false;
+  built = false;
+}
+
+/**
+ * Adds the memory of the cached reports and their row index to a breakdown.
+ *
+ * @param stats The breakdown to add to.
+ */
+void InventoryCache::accountMemory(MemoryStats &stats) const {
+  if(!built) {
+    return;
+  }
+
+  stats.add(MemoryStats::InventoryReports, movies.capacity() * sizeof(const Movie*)
+    + offsets.capacity() * sizeof(size_t) + stale.capacity() 
+    + (dirty.capacity() + spareDirty.capacity()) * sizeof(unsigned) 
+    + report->capacity() + 1 + (spare != nullptr ? spare->capacity() + 1 : 0));
+}
+
+/**
+ * Renders the whole report and starts watching every movie in it. The 
+ * rows are rendered in chunks on the thread pool, then joined in order.
+ *
+ * @param tree The genre's MovieTree.
+ * @param pool The thread pool to render the chunks on.
+ */
+void InventoryCache::rebuild(const MovieTree &tree, ThreadPool &pool) {
+  reset();
+  tree.collect(movies);
+  offsets.resize(movies.size() + 1);
+  stale.assign(movies.size(), 0);
+  dirty.resize(movies.size());
+
+  vector<string> chunks((movies.size() + rowsPerChunk - 1) / rowsPerChunk);
+  pool.parallelFor(0, chunks.size(), 1, [this, &chunks](size_t first, size_t last) {
+    for(size_t chunk = first; chunk < last; chunk++) {
+      renderRows(chunk * rowsPerChunk, min(movies.size(), (chunk + 1) * rowsPerChunk), 
+        chunks[chunk]);
+    }
+  });
+
+  report = make_shared<string>("Available Movies: \n"
+    "------------------------------------------------------\n");
+  size_t length = report->size() + 1;
+
+  for(const string &chunk : chunks) {
+    length += chunk.size();
+  }
+
+  report->reserve(length);
+
+  for(size_t chunk = 0; chunk < chunks.size(); chunk++) {
+    size_t base = report->size();
+    size_t last = min(movies.size(), (chunk + 1) * rowsPerChunk);
+
+    for(size_t row = chunk * rowsPerChunk; row < last; row++) {
+      offsets[row] += base;
+    }
+
+    report->append(chunks[chunk]);
+    string().swap(chunks[chunk]);
+  }
+
+  offsets[movies.size()] = report->size();
+  report->push_back('\n');
+  built = true;
+}
+
+/**
+ * Renders a range of rows into a buffer of their own, recording where 
+ * each row starts within the buffer, and starts watching their movies.
+ *
+ * @param first The first row to render.
+ * @param last One past the last row to render.
+ * @param output The buffer to render the rows into.
+ */
+void InventoryCache::renderRows(size_t first, size_t last, string &output) {
+  ReportWriter::StringSink sink(output);
+  ReportWriter out(sink);
+
+  for(size_t row = first; row < last; row++) {
+    out.flush();
+    offsets[row] = output.size();
+    movies[row]->displayInfo(out, movies[row]->getStock());
+    movies[row]->watchStock(this, row);
+  }
+}
+
+/**
+ * Builds the next report in the spare and makes it the current report, 
+ * leaving the current one as the new spare. The spare is first brought up
+ * to date with the current report, by copying the rows it is behind by, 
+ * and then the stale rows are re-rendered into it in row order. A row 
+ * that keeps its length is overwritten in place; if any row changes 
+ * length, the rest of the report is moved in a single pass.
+ */
+void InventoryCache::updateStaleRows() {
+  size_t count = dirtyCount.exchange(0, memory_order_relaxed);
+  sort(dirty.begin(), dirty.begin() + count);
+
+  if(spare == nullptr || spare.use_count() > 1) {
+    // A caller still holds the spare, so start a new one.
+    spare = make_shared<string>(*report);
+
+  } else if(spareReflowed) {
+      spare->assign(*report);
+
+  } else {
+      for(unsigned i : spareDirty) {
+        memcpy(&(*spare)[offsets[i]], report->data() + offsets[i], offsets[i + 1] - offsets[i]);
+      }
+  }
+
+  string row, moved;
+  ReportWriter::StringSink sink(row);
+  ReportWriter out(sink, 256);
+  bool reflowed = false;
+  size_t copied = 0;      // how much of the spare has been moved so far
+  size_t next = 0;        // the first row whose offset has not been moved
+  size_t shift = 0;       // how far the rows after the last stale row move
+
+  for(size_t k = 0; k < count; k++) {
+    unsigned i = dirty[k];
+    stale[i] = 0;
+    row.clear();
+    movies[i]->displayInfo(out, movies[i]->getStock());
+    out.flush();
+    size_t start = offsets[i], length = offsets[i + 1] - start;
+
+    if(!reflowed && row.size() == length) {
+      memcpy(&(*spare)[start], row.data(), length);
+      continue;
+    }
+
+    if(!reflowed) {
+      reflowed = true;
+      moved.reserve(spare->size() + spare->size() / 64);
+      next = i;
+    }
+
+    moved.append(*spare, copied, start - copied).append(row);
+    copied = start + length;
+
+    for(; next <= i; next++) {
+      offsets[next] += shift;
+    }
+
+    shift += row.size() - length;
+  }
+
+  if(reflowed) {
+    moved.append(*spare, copied, string::npos);
+
+    for(; next < offsets.size(); next++) {
+      offsets[next] += shift;
+    }
+
+    spare->swap(moved);
+  }
+
+  spareDirty.assign(dirty.begin(), dirty.begin() + count);
+  spareReflowed = reflowed;
+  swap(report, spare);
+}
+
+/**
+ * Class Destructor
+ */
+InventoryCache::~InventoryCache() {
+  reset();
+}
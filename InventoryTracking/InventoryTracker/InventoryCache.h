@@ -0,0 +1,67 @@
+#ifndef INVENTORYCACHE_H
+#define INVENTORYCACHE_H
+
+/**
+ * InventoryCache - a pre-rendered inventory report for one genre's movies,
+ * kept up to date row by row.
+ *
+ * The first report renders every movie of the MovieTree into one string, 
+ * remembering where each movie's row starts. Each movie is then watched: 
+ * when `StockTable::changed` reports that its stock changed, its row is 
+ * added to a list of stale rows. The next report re-renders only the rows
+ * on that list, in place when the row keeps its length, so reporting an 
+ * inventory costs time in proportion to the rows that changed. A movie's 
+ * row only changes length when its stock goes negative or outgrows its 
+ * column; the rest of the report is then moved once for all such rows.
+ * 
+ * The report is double-buffered: a caller may keep a report it was given 
+ * while the cache moves on. The cache keeps the previous report as a 
+ * spare and, once no caller holds it, brings it up to date and hands it 
+ * out next. The text is only copied when a caller still holds both.
+ *
+ * Rendering from scratch is split into chunks of consecutive rows, 
+ * which are rendered concurrently on a thread pool into separate buffers 
+ * and then joined in order.
+ *
+ * Rows may be marked stale from several threads at once, as long as each 
+ * movie is only updated by one thread at a time; `refresh` must not run 
+ * concurrently with stock updates.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "MovieTree.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+
+class InventoryCache {
+public:
+  InventoryCache();
+  shared_ptr<const string> refresh(const MovieTree &, ThreadPool &);
+  void invalidate(size_t);
+  void reset();
+  void accountMemory(MemoryStats &) const;
+  ~InventoryCache();
+
+private:
+  vector<const Movie*> movies;      // the cached movies, in display order
+  vector<size_t> offsets;           // where each row starts; the last entry ends the rows
+  vector<char> stale;               // nonzero for rows already in `dirty`
+  vector<unsigned> dirty;           // the stale rows, in the order they went stale
+  atomic<size_t> dirtyCount;        // the number of rows in `dirty`
+  shared_ptr<string> report;        // the current report
+  shared_ptr<string> spare;         // the previous report, to be reused
+  vector<unsigned> spareDirty;      // the rows the spare is behind the report by
+  bool spareReflowed;               // true if rows moved since the spare was current
+  bool built;
+
+  void rebuild(const MovieTree &, ThreadPool &);
+  void renderRows(size_t, size_t, string &);
+  void updateStaleRows();
+};
+#endif // INVENTORYCACHE_H
@@ -0,0 +1,189 @@
+/**
+ * LatencyHistogram - a histogram of latencies in nanoseconds with a fixed
+ * relative precision, in the manner of an HDR histogram.
+ *
+ * Latencies below 64 ns each have their own bucket. Above that, every 
+ * power of two is split into 64 equal buckets, so a latency is recorded 
+ * to within about 1.6% of its value whatever its size, and recording one 
+ * is a few shifts and an increment. Latencies are counted up to 2^41 ns,
+ * about 36 minutes; longer ones are counted in a separate overflow bucket,
+ * and a percentile that falls in it is reported as the largest latency.
+ * Other percentiles are reported as the highest latency of the bucket they
+ * fall in, so they are never understated.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "LatencyHistogram.h"
+#include <cmath>
+using namespace std;
+
+/**
+ * Constructs an empty histogram.
+ */
+LatencyHistogram::LatencyHistogram()
+  : counts(buckets, 0), recorded(0), sum(0), largest(0) {
+}
+
+/**
+ * Records one latency.
+ *
+ * @param nanoseconds The latency; negative values are recorded as 0.
+ */
+void LatencyHistogram::record(long long nanoseconds) {
+  if(nanoseconds < 0) {
+    nanoseconds = 0;
+  }
+
+  counts[bucketOf(nanoseconds)]++;
+  recorded++;
+  sum += nanoseconds;
+
+  if(nanoseconds > largest) {
+    largest = nanoseconds;
+  }
+}
+
+/**
+ * Adds another histogram's latencies to this one.
+ *
+ * @param other The histogram to add.
+ */
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+  for(int i = 0; i < buckets; i++) {
+    counts[i] += other.counts[i];
+  }
+
+  recorded += other.recorded;
+  sum += other.sum;
+
+  if(other.largest > largest) {
+    largest = other.largest;
+  }
+}
+
+/**
+ * Forgets every latency recorded so far.
+ */
+void LatencyHistogram::reset() {
+  counts.assign(buckets, 0);
+  recorded = sum = largest = 0;
+}
+
+/**
+ * Returns the number of latencies recorded.
+ *
+ * @return The count.
+ */
+long long LatencyHistogram::count() const {
+  return recorded;
+}
+
+/**
+ * Returns the sum of the latencies recorded.
+ *
+ * @return The total in nanoseconds.
+ */
+long long LatencyHistogram::total() const {
+  return sum;
+}
+
+/**
+ * Returns the largest latency recorded, exactly.
+ *
+ * @return The maximum in nanoseconds, or 0 if none was recorded.
+ */
+long long LatencyHistogram::max() const {
+  return largest;
+}
+
+/**
+ * Returns the mean of the latencies recorded, exactly.
+ *
+ * @return The mean in nanoseconds, or 0 if none was recorded.
+ */
+double LatencyHistogram::mean() const {
+  return recorded == 0 ? 0 : double(sum) / recorded;
+}
+
+/**
+ * Returns the latency that a given percentage of the recorded latencies 
+ * are at or below.
+ *
+ * @param percent The percentile, from 0 to 100, such as 99.9.
+ * @return The latency in nanoseconds, to within the histogram's precision,
+ *         or 0 if none was recorded.
+ */
+long long LatencyHistogram::percentile(double percent) const {
+  long long rank = (long long)ceil(percent / 100 * recorded);
+  long long seen = 0;
+
+  if(rank < 1) {
+    rank = 1;
+  }
+
+  for(int i = 0; i < buckets; i++) {
+    seen += counts[i];
+
+    if(seen >= rank && i != overflowBucket) {
+      long long highest = highestIn(i);
+      return highest < largest ? highest : largest;
+    }
+  }
+
+  return largest;
+}
+
+/**
+ * Adds the memory of the histogram's buckets to a breakdown.
+ *
+ * @param stats The breakdown to add to.
+ * @param subsystem The subsystem the histogram belongs to.
+ */
+void LatencyHistogram::accountMemory(MemoryStats &stats, MemoryStats::Subsystem subsystem) const {
+  stats.add(subsystem, sizeof(LatencyHistogram) + counts.capacity() * sizeof(long long));
+}
+
+/**
+ * Returns the bucket a latency is counted in.
+ *
+ * @param nanoseconds A latency of 0 or more.
+ * @return The bucket's index.
+ */
+int LatencyHistogram::bucketOf(long long nanoseconds) {
+  if(nanoseconds < subBuckets) {
+    return (int)nanoseconds;
+  }
+
+  // The shift keeps the top subBucketBits + 1 bits of the latency, whose
+  // leading bit is always set, so they pick one of 64 buckets.
+  int shift = 63 - __builtin_clzll(nanoseconds) - subBucketBits;
+
+  if(shift > maxShift) {
+    return overflowBucket;
+  }
+
+  return subBuckets * (shift + 1) + (int)(nanoseconds >> shift) - subBuckets;
+}
+
+/**
+ * Returns the highest latency counted in a bucket.
+ *
+ * @param bucket The bucket's index.
+ * @return The latency in nanoseconds.
+ */
+long long LatencyHistogram::highestIn(int bucket) {
+  if(bucket < subBuckets) {
+    return bucket;
+  }
+
+  int shift = bucket / subBuckets - 1;
+  long long lowest = (long long)(subBuckets + bucket % subBuckets) << shift;
+  return lowest + (1LL << shift) - 1;
+}
+
+/**
+ * Class Destructor
+ */
+LatencyHistogram::~LatencyHistogram() {}
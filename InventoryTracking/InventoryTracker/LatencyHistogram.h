@@ -0,0 +1,54 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+/**
+ * LatencyHistogram - a histogram of latencies in nanoseconds with a fixed
+ * relative precision, in the manner of an HDR histogram.
+ *
+ * Latencies below 64 ns each have their own bucket. Above that, every 
+ * power of two is split into 64 equal buckets, so a latency is recorded 
+ * to within about 1.6% of its value whatever its size, and recording one 
+ * is a few shifts and an increment. Latencies are counted up to 2^41 ns,
+ * about 36 minutes; longer ones are counted in a separate overflow bucket,
+ * and a percentile that falls in it is reported as the largest latency.
+ * Other percentiles are reported as the highest latency of the bucket they
+ * fall in, so they are never understated.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "MemoryStats.h"
+#include <vector>
+using namespace std;
+
+class LatencyHistogram {
+public:
+  LatencyHistogram();
+  void record(long long);
+  void merge(const LatencyHistogram &);
+  void reset();
+  long long count() const;
+  long long total() const;
+  long long max() const;
+  double mean() const;
+  long long percentile(double) const;
+  void accountMemory(MemoryStats &, MemoryStats::Subsystem) const;
+  ~LatencyHistogram();
+
+private:
+  static const int subBucketBits = 6;
+  static const int subBuckets = 1 << subBucketBits;
+  static const int maxShift = 34;   // latencies below 2^41 ns
+  static const int overflowBucket = subBuckets * (maxShift + 2);
+  static const int buckets = overflowBucket + 1;
+
+  vector<long long> counts;
+  long long recorded;
+  long long sum;
+  long long largest;
+
+  static int bucketOf(long long);
+  static long long highestIn(int);
+};
+#endif // LATENCYHISTOGRAM_H
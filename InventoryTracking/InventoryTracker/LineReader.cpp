@@ -0,0 +1,365 @@
+/**
+ * LineReader - a class that reads a text file line by line, decompressing
+ * it on the fly when it is gzip- or zstd-compressed.
+ *
+ * Compression is detected from the file's leading magic bytes. Compressed
+ * files are streamed through the system's `gzip` or `zstd` decompressor in a
+ * child process, so no decompressed copy is ever written to disk. A
+ * background thread reads the (decompressed) bytes in large blocks and
+ * queues them for the caller, so reading and decompression overlap with
+ * whatever the caller does with each line. A read that fails is reported
+ * by `close`, so a file cut short by an I/O error is never mistaken for a 
+ * complete one.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "LineReader.h"
+#include "Trace.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+using namespace std;
+
+/**
+ * Constructs a reader for the given file. The file is not opened until
+ * `open` is called.
+ *
+ * @param name The path of the file to read.
+ */
+LineReader::LineReader(const string &name)
+  : fileName(name), inputDescriptor(-1), decompressor(-1), compressed(false),
+    finished(false), stopped(false), readError(0), current(""), position(0) {
+}
+
+/**
+ * Opens the file, starts a decompressor if its magic bytes show it is 
+ * compressed, and starts the background thread that reads it in blocks.
+ *
+ * @return true if the file was opened and, if needed, the decompressor 
+ *         was started; false otherwise.
+ */
+bool LineReader::open() {
+  inputDescriptor = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if(inputDescriptor < 0) {
+    return false;
+  }
+
+  const char *program = detectDecompressor(inputDescriptor);
+
+  if(program != nullptr) {
+    compressed = startDecompressor(program);
+
+    if(!compressed) {
+      return false;
+    }
+  }
+
+  producer = thread(&LineReader::readBlocks, this);
+  return true;
+}
+
+/**
+ * Names the decompressor for a file from its leading magic bytes.
+ *
+ * @param descriptor The open file.
+ * @return "gzip" or "zstd" if the file is compressed; nullptr otherwise.
+ */
+const char *LineReader::detectDecompressor(int descriptor) {
+  unsigned char magic[4] = {0, 0, 0, 0};
+  ssize_t magicLength = pread(descriptor, magic, sizeof(magic), 0);
+
+  if(magicLength >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+    return "gzip";
+  }
+
+  if(magicLength == 4 && magic[0] == 0x28 && magic[1] == 0xb5
+    && magic[2] == 0x2f && magic[3] == 0xfd) {
+    return "zstd";
+  }
+
+  return nullptr;
+}
+
+/**
+ * Starts the named decompressor with the file as its standard input and
+ * replaces the input descriptor with a pipe carrying its output.
+ *
+ * @param program The decompressor to run ("gzip" or "zstd").
+ * @return true if the decompressor was started; false otherwise.
+ */
+bool LineReader::startDecompressor(const char *program) {
+  int output[2];
+
+  if(pipe2(output, O_CLOEXEC) != 0) {
+    return false;
+  }
+
+  bool started = spawnDecompressor(program, inputDescriptor, output[1], decompressor);
+  ::close(output[1]);
+  ::close(inputDescriptor);
+  inputDescriptor = output[0];
+
+  if(!started) {
+    decompressor = -1;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Runs a decompressor in a child process, without a shell, reading the 
+ * compressed data from one descriptor and writing the decompressed data 
+ * to another.
+ *
+ * @param program The decompressor to run ("gzip" or "zstd").
+ * @param input The descriptor to use as the decompressor's standard input.
+ * @param output The descriptor to use as its standard output.
+ * @param child Set to the decompressor's process ID.
+ * @return true if the decompressor was started; false otherwise.
+ */
+bool LineReader::spawnDecompressor(const char *program, int input, int output, pid_t &child) {
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_adddup2(&actions, input, STDIN_FILENO);
+  posix_spawn_file_actions_adddup2(&actions, output, STDOUT_FILENO);
+
+  char *arguments[] = {const_cast<char *>(program), const_cast<char *>("-dc"), nullptr};
+  int result = posix_spawnp(&child, program, &actions, nullptr, arguments, environ);
+  posix_spawn_file_actions_destroy(&actions);
+  return result == 0;
+}
+
+/**
+ * Body of the background thread. Reads the input in large blocks and 
+ * queues them, waiting whenever the queue is full so that memory use 
+ * stays bounded. Each block's reads are traced as a span on this thread's
+ * own row, apart from the time spent waiting for room in the queue. A read
+ * interrupted by a signal is retried; any other failed read ends the input
+ * like the end of the file, and its error is kept for `close` to report.
+ */
+void LineReader::readBlocks() {
+  while(true) {
+    string block(blockSize, '\0');
+    size_t filled = 0;
+    int error = 0;
+
+    {
+      Trace::Span span("LineReader::readBlocks read");
+
+      while(filled < blockSize) {
+        ssize_t bytesRead = read(inputDescriptor, &block[filled], blockSize - filled);
+
+        if(bytesRead > 0) {
+          filled += bytesRead;
+
+        } else if(bytesRead < 0 && errno == EINTR) {
+            continue;
+
+        } else {
+            error = bytesRead < 0 ? errno : 0;
+            break;
+        }
+      }
+    }
+
+    block.resize(filled);
+    unique_lock<mutex> lock(queueLock);
+    queueChanged.wait(lock, [this] { return stopped || blocks.size() < maxQueuedBlocks; });
+    readError = error;
+
+    if(stopped) {
+      return;
+    }
+
+    if(filled > 0) {
+      blocks.push_back(move(block));
+    }
+
+    if(filled < blockSize) {
+      finished = true;
+      queueChanged.notify_all();
+      return;
+    }
+
+    queueChanged.notify_all();
+  }
+}
+
+/**
+ * Replaces the current block with the next queued one, waiting for the
+ * background thread if necessary.
+ *
+ * @return true if another block is available; false at the end of the input.
+ */
+bool LineReader::nextBlock() {
+  unique_lock<mutex> lock(queueLock);
+  queueChanged.wait(lock, [this] { return finished || !blocks.empty(); });
+
+  if(blocks.empty()) {
+    return false;
+  }
+
+  current = move(blocks.front());
+  blocks.pop_front();
+  position = 0;
+  queueChanged.notify_all();
+  return true;
+}
+
+/**
+ * Reads the next line, without its newline. Like `std::getline`, a final
+ * line that is not terminated by a newline is still returned.
+ *
+ * @param line Receives the line read.
+ * @return true if a line was read; false at the end of the input.
+ */
+bool LineReader::getline(string &line) {
+  line.clear();
+  bool any = false;
+
+  while(true) {
+    if(position >= current.size()) {
+      if(!nextBlock()) {
+        return any;
+      }
+    }
+
+    size_t newline = current.find('\n', position);
+
+    if(newline != string::npos) {
+      line.append(current, position, newline - position);
+      position = newline + 1;
+      return true;
+    }
+
+    line.append(current, position, string::npos);
+    position = current.size();
+    any = true;
+  }
+}
+
+/**
+ * Reports whether the file is being decompressed while it is read.
+ *
+ * @return true if the file is gzip- or zstd-compressed; false otherwise.
+ */
+bool LineReader::isCompressed() const {
+  return compressed;
+}
+
+/**
+ * Stops the background thread, closes the file and waits for the 
+ * decompressor, if any, to exit.
+ *
+ * @return false if a read failed or the decompressor reported an error;
+ *         true otherwise.
+ */
+bool LineReader::close() {
+  {
+    lock_guard<mutex> lock(queueLock);
+    stopped = true;
+  }
+
+  queueChanged.notify_all();
+
+  if(producer.joinable()) {
+    producer.join();
+  }
+
+  if(inputDescriptor >= 0) {
+    ::close(inputDescriptor);
+    inputDescriptor = -1;
+  }
+
+  bool succeeded = readError == 0;
+
+  if(decompressor > 0) {
+    int status = 0;
+
+    // A reader that stops early would otherwise leave the decompressor 
+    // blocked on a full pipe; closing the pipe makes it exit on SIGPIPE.
+    waitpid(decompressor, &status, 0);
+    succeeded = succeeded && ((WIFEXITED(status) && WEXITSTATUS(status) == 0)
+      || (WIFSIGNALED(status) && WTERMSIG(status) == SIGPIPE));
+    decompressor = -1;
+  }
+
+  return succeeded;
+}
+
+/**
+ * Describes why `close` reported a failure.
+ *
+ * @return The error of the read that failed, or a note that the 
+ *         decompressor failed if every read succeeded.
+ */
+string LineReader::getErrorMessage() const {
+  return readError != 0 ? strerror(readError) : "the decompressor failed";
+}
+
+/**
+ * Reports whether a file is gzip- or zstd-compressed, judged by its 
+ * leading magic bytes as `open` judges it.
+ *
+ * @param name The path of the file.
+ * @return true if the file is compressed; false if it is not or cannot 
+ *         be opened.
+ */
+bool LineReader::isCompressedFile(const string &name) {
+  int descriptor = ::open(name.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if(descriptor < 0) {
+    return false;
+  }
+
+  bool compressedFile = detectDecompressor(descriptor) != nullptr;
+  ::close(descriptor);
+  return compressedFile;
+}
+
+/**
+ * Decompresses a gzip- or zstd-compressed file into another file, running
+ * the decompressor as `open` does.
+ *
+ * @param name The path of the compressed file.
+ * @param outputName The path to write the decompressed data to.
+ * @return true if the file was compressed and the decompressor succeeded;
+ *         false otherwise.
+ */
+bool LineReader::decompressFile(const string &name, const string &outputName) {
+  int input = ::open(name.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if(input < 0) {
+    return false;
+  }
+
+  const char *program = detectDecompressor(input);
+  int output = program == nullptr ? -1 
+    : ::open(outputName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  pid_t child = -1;
+  bool started = output >= 0 && spawnDecompressor(program, input, output, child);
+  ::close(input);
+
+  if(output >= 0) {
+    ::close(output);
+  }
+
+  int status = 0;
+  return started && waitpid(child, &status, 0) == child 
+    && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/**
+ * Class Destructor
+ */
+LineReader::~LineReader() {
+  close();
+}
@@ -0,0 +1,65 @@
+#ifndef LINEREADER_H
+#define LINEREADER_H
+
+/**
+ * LineReader - a class that reads a text file line by line, decompressing
+ * it on the fly when it is gzip- or zstd-compressed.
+ *
+ * Compression is detected from the file's leading magic bytes. Compressed
+ * files are streamed through the system's `gzip` or `zstd` decompressor in a
+ * child process, so no decompressed copy is ever written to disk. A
+ * background thread reads the (decompressed) bytes in large blocks and
+ * queues them for the caller, so reading and decompression overlap with
+ * whatever the caller does with each line. A read that fails is reported
+ * by `close`, so a file cut short by an I/O error is never mistaken for a 
+ * complete one.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <sys/types.h>
+using namespace std;
+
+class LineReader {
+public:
+  LineReader(const string &);
+  bool open();
+  bool getline(string &);
+  bool isCompressed() const;
+  bool close();
+  string getErrorMessage() const;
+  static bool isCompressedFile(const string &);
+  static bool decompressFile(const string &, const string &);
+  ~LineReader();
+
+private:
+  static const size_t blockSize = 1 << 20;
+  static const size_t maxQueuedBlocks = 4;
+
+  string fileName;
+  int inputDescriptor;
+  pid_t decompressor;
+  bool compressed;
+  thread producer;
+  mutex queueLock;
+  condition_variable queueChanged;
+  deque<string> blocks;
+  bool finished;
+  bool stopped;
+  int readError;          // the errno of a failed read, or 0
+  string current;
+  size_t position;
+
+  bool startDecompressor(const char *);
+  static const char *detectDecompressor(int);
+  static bool spawnDecompressor(const char *, int, int, pid_t &);
+  void readBlocks();
+  bool nextBlock();
+};
+#endif // LINEREADER_H
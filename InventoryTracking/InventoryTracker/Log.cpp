@@ -0,0 +1,400 @@
+/**
+ * Log - an asynchronous sink for the Store's error and status messages.
+ *
+ * Each kind of message has a fixed type and severity. Writing one only
+ * counts it and enqueues its type and detail on a bounded lock-free ring
+ * buffer; a background writer thread formats the queued messages and writes
+ * them to standard error in batches. Messages below the current severity
+ * level are counted but not written, and each type can be limited to a
+ * number of messages per second, with the rest counted as suppressed and
+ * summarised by the writer.
+ *
+ * A thread can capture its messages with a Capture, which writes them
+ * straight to a stream instead, in order with the rest of that stream's
+ * output. The command server uses this to return errors with each reply.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "Log.h"
+#include "ReportWriter.h"
+#include <chrono>
+#include <cstring>
+using namespace std;
+
+namespace {
+  // The stream this thread's messages are captured to, if any.
+  thread_local ostream *capturedOutput = nullptr;
+}
+
+const Log::Format Log::formats[Log::messageTypes] = {
+  {"customer not found", Log::Error, "Error: customer not found!", ""},
+  {"movie not found", Log::Error, "Error: movie not found!", ""},
+  {"out of stock", Log::Warning, "Error: this Movie is out of stock.", ""},
+  {"trace write failed", Log::Error, "Error writing trace file ", "."},
+  {"transaction unsuccessful", Log::Error, "Error: transaction unsuccessful!", ""},
+  {"unknown genre", Log::Error, "Error: unknown genre ", "."},
+  {"unknown genre code", Log::Error, "Error: unknown genre code ", "."},
+  {"unknown transaction code", Log::Error, "Error: unknown transaction code ", "."},
+  {"unknown transaction type", Log::Error, "Error: unknown transaction type ", " encountered."}
+};
+
+/**
+ * Starts capturing this thread's messages to a stream. Captured messages
+ * are written immediately, and are neither queued nor rate limited.
+ *
+ * @param out The stream to write this thread's messages to.
+ */
+Log::Capture::Capture(ostream &out) : previous(capturedOutput) {
+  capturedOutput = &out;
+}
+
+/**
+ * Class Destructor
+ * Restores the capture that was in effect before this one, if any.
+ */
+Log::Capture::~Capture() {
+  capturedOutput = previous;
+}
+
+/**
+ * Constructs the log and starts its writer thread.
+ */
+Log::Log()
+  : slots(new Slot[capacity]), enqueuePosition(0), dequeuePosition(0),
+    level(Info), rateLimit(0), writtenPosition(0), sleeping(false), stopping(false) {
+  for(size_t i = 0; i < capacity; i++) {
+    slots[i].sequence.store(i, memory_order_relaxed);
+  }
+
+  for(int i = 0; i < messageTypes; i++) {
+    counts[i] = suppressedCounts[i] = unreported[i] = windowStart[i] = 0;
+    windowCount[i] = 0;
+  }
+
+  writer = thread(&Log::run, this);
+}
+
+/**
+ * Returns the log shared by the whole program, starting it on first use.
+ *
+ * @return The log.
+ */
+Log &Log::instance() {
+  static Log log;
+  return log;
+}
+
+/**
+ * Writes a message. The message is counted and, unless it is below the
+ * current level or over its rate limit, queued for the writer thread, or
+ * written straight to this thread's capture stream if there is one.
+ *
+ * @param message The type of message.
+ * @param detail The text filled into the message, such as a genre code.
+ */
+void Log::write(Message message, const string &detail) {
+  Log &log = instance();
+  log.counts[message].fetch_add(1, memory_order_relaxed);
+
+  if(formats[message].severity < log.level.load(memory_order_relaxed)) {
+    return;
+  }
+
+  if(capturedOutput != nullptr) {
+    string line;
+    format(line, message, detail.data(), detail.size());
+    *capturedOutput << line;
+    return;
+  }
+
+  if(log.admit(message)) {
+    log.enqueue(message, detail.data(), detail.size());
+  }
+}
+
+/**
+ * Writes a message whose detail is a single character, such as a genre or
+ * transaction code.
+ *
+ * @param message The type of message.
+ * @param detail The character filled into the message.
+ */
+void Log::write(Message message, char detail) {
+  write(message, string(1, detail));
+}
+
+/**
+ * Sets the lowest severity of message that is written. Messages below it
+ * are still counted.
+ *
+ * @param severity The lowest severity to write, or Off to write nothing.
+ */
+void Log::setLevel(Severity severity) {
+  instance().level.store(severity, memory_order_relaxed);
+}
+
+/**
+ * Sets the lowest severity of message that is written from its name.
+ *
+ * @param name "debug", "info", "warning", "error" or "off".
+ * @return false if the name is unknown; true otherwise.
+ */
+bool Log::setLevel(const string &name) {
+  const char *names[] = {"debug", "info", "warning", "error", "off"};
+
+  for(int i = Debug; i <= Off; i++) {
+    if(name == names[i]) {
+      setLevel(static_cast<Severity>(i));
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Limits how many messages of each type are written per second. Messages
+ * over the limit are counted as suppressed, and the writer reports how
+ * many were suppressed. Captured messages are never limited.
+ *
+ * @param messagesPerSecond The limit for each message type, or 0 for none.
+ */
+void Log::setRateLimit(int messagesPerSecond) {
+  instance().rateLimit.store(max(0, messagesPerSecond), memory_order_relaxed);
+}
+
+/**
+ * Returns how many messages of a type have been written, including those
+ * that were filtered out or suppressed.
+ *
+ * @param message The type of message.
+ * @return The number of messages of that type.
+ */
+long long Log::count(Message message) {
+  return instance().counts[message].load(memory_order_relaxed);
+}
+
+/**
+ * Returns how many messages of a type were dropped by the rate limit.
+ *
+ * @param message The type of message.
+ * @return The number of suppressed messages of that type.
+ */
+long long Log::suppressed(Message message) {
+  return instance().suppressedCounts[message].load(memory_order_relaxed);
+}
+
+/**
+ * Waits until every message queued so far has been written.
+ */
+void Log::flush() {
+  Log &log = instance();
+  size_t target = log.enqueuePosition.load(memory_order_acquire);
+  unique_lock<mutex> lock(log.wakeLock);
+  log.wakeup.notify_one();
+  log.written.wait(lock, [&log, target] {
+    return log.writtenPosition.load(memory_order_acquire) >= target;
+  });
+}
+
+/**
+ * Formats a message as a line of text.
+ *
+ * @param line Receives the formatted line.
+ * @param message The type of message.
+ * @param detail The text filled into the message.
+ * @param length The length of the detail.
+ */
+void Log::format(string &line, Message message, const char *detail, size_t length) {
+  line.append(formats[message].before);
+  line.append(detail, length);
+  line.append(formats[message].after);
+  line += '\n';
+}
+
+/**
+ * Applies the rate limit to a message about to be queued. Each message
+ * type may be written up to the limit within each second.
+ *
+ * @param message The type of message.
+ * @return true if the message may be written; false if it is suppressed.
+ */
+bool Log::admit(Message message) {
+  int limit = rateLimit.load(memory_order_relaxed);
+  if(limit == 0) {
+    return true;
+  }
+
+  long long second = chrono::duration_cast<chrono::seconds>(
+    chrono::steady_clock::now().time_since_epoch()).count();
+  long long start = windowStart[message].load(memory_order_relaxed);
+
+  if(second != start && windowStart[message].compare_exchange_strong(start, second)) {
+    windowCount[message].store(0, memory_order_relaxed);
+  }
+
+  if(windowCount[message].fetch_add(1, memory_order_relaxed) < limit) {
+    return true;
+  }
+
+  suppressedCounts[message].fetch_add(1, memory_order_relaxed);
+  unreported[message].fetch_add(1, memory_order_relaxed);
+  return false;
+}
+
+/**
+ * Adds a message to the ring buffer. Each slot carries a sequence number
+ * that says whether it is free for the producer at a given position or
+ * holds a message for the consumer, so producers only claim positions
+ * with a compare-and-swap. If the buffer is full the producer yields until
+ * the writer frees a slot, so no message is lost.
+ *
+ * @param message The type of message.
+ * @param detail The text filled into the message; it is truncated to fit.
+ * @param length The length of the detail.
+ */
+void Log::enqueue(Message message, const char *detail, size_t length) {
+  size_t position = enqueuePosition.load(memory_order_relaxed);
+  Slot *slot;
+
+  while(true) {
+    slot = &slots[position & (capacity - 1)];
+    size_t sequence = slot->sequence.load(memory_order_acquire);
+    long long difference = static_cast<long long>(sequence - position);
+
+    if(difference == 0) {
+      if(enqueuePosition.compare_exchange_weak(position, position + 1)) {
+        break;
+      }
+
+    } else if(difference < 0) {
+        wake();
+        this_thread::yield();
+        position = enqueuePosition.load(memory_order_relaxed);
+
+    } else {
+        position = enqueuePosition.load(memory_order_relaxed);
+    }
+  }
+
+  slot->message = message;
+  slot->length = static_cast<unsigned char>(min(length, sizeof(slot->detail)));
+  memcpy(slot->detail, detail, slot->length);
+  slot->sequence.store(position + 1, memory_order_release);
+
+  // The claim above and this check are ordered against the writer's store
+  // to `sleeping` and its check of the queue, so a writer going to sleep
+  // either sees this message or is seen to be sleeping here.
+  if(sleeping.load()) {
+    wake();
+  }
+}
+
+/**
+ * Takes the oldest message off the ring buffer.
+ *
+ * @param message Receives the type of message.
+ * @param detail Receives the text filled into the message.
+ * @return true if a message was taken; false if the buffer is empty.
+ */
+bool Log::dequeue(Message &message, string &detail) {
+  size_t position = dequeuePosition.load(memory_order_relaxed);
+  Slot *slot;
+
+  while(true) {
+    slot = &slots[position & (capacity - 1)];
+    size_t sequence = slot->sequence.load(memory_order_acquire);
+    long long difference = static_cast<long long>(sequence - (position + 1));
+
+    if(difference == 0) {
+      if(dequeuePosition.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+        break;
+      }
+
+    } else if(difference < 0) {
+        return false;
+
+    } else {
+        position = dequeuePosition.load(memory_order_relaxed);
+    }
+  }
+
+  message = slot->message;
+  detail.assign(slot->detail, slot->length);
+  slot->sequence.store(position + capacity, memory_order_release);
+  return true;
+}
+
+/**
+ * Wakes the writer thread.
+ */
+void Log::wake() {
+  lock_guard<mutex> lock(wakeLock);
+  wakeup.notify_one();
+}
+
+/**
+ * The writer thread's loop. Queued messages are formatted into a buffer
+ * that is written to standard error whenever the queue runs dry, along
+ * with a summary of any messages the rate limit suppressed. The writer
+ * then sleeps until a producer wakes it, and stops once the log is being
+ * destroyed and the queue is empty.
+ */
+void Log::run() {
+  ReportWriter::DescriptorSink standardError(2);
+  ReportWriter out(standardError);
+  Message message;
+  string detail, line;
+
+  while(true) {
+    while(dequeue(message, detail)) {
+      line.clear();
+      format(line, message, detail.data(), detail.size());
+      out.write(line);
+    }
+
+    for(int i = 0; i < messageTypes; i++) {
+      long long dropped = unreported[i].exchange(0, memory_order_relaxed);
+
+      if(dropped > 0) {
+        out.write("Log: suppressed ").write(to_string(dropped)).write(" \"")
+          .write(formats[i].name).write("\" messages.").endLine();
+      }
+    }
+
+    out.flush();
+    size_t position = dequeuePosition.load(memory_order_relaxed);
+    unique_lock<mutex> lock(wakeLock);
+    writtenPosition.store(position, memory_order_release);
+    written.notify_all();
+
+    if(stopping.load(memory_order_relaxed)
+      && position == enqueuePosition.load(memory_order_acquire)) {
+      break;
+    }
+
+    sleeping.store(true);
+
+    if(position == enqueuePosition.load()) {
+      wakeup.wait_for(lock, chrono::milliseconds(50));
+    }
+
+    sleeping.store(false, memory_order_relaxed);
+  }
+}
+
+/**
+ * Class Destructor
+ * Stops the writer thread once every queued message has been written.
+ */
+Log::~Log() {
+  {
+    lock_guard<mutex> lock(wakeLock);
+    stopping.store(true, memory_order_relaxed);
+    wakeup.notify_one();
+  }
+
+  writer.join();
+}
@@ -0,0 +1,114 @@
+#ifndef LOG_H
+#define LOG_H
+
+/**
+ * Log - an asynchronous sink for the Store's error and status messages.
+ *
+ * Each kind of message has a fixed type and severity. Writing one only
+ * counts it and enqueues its type and detail on a bounded lock-free ring
+ * buffer; a background writer thread formats the queued messages and writes
+ * them to standard error in batches. Messages below the current severity
+ * level are counted but not written, and each type can be limited to a
+ * number of messages per second, with the rest counted as suppressed and
+ * summarised by the writer.
+ *
+ * A thread can capture its messages with a Capture, which writes them
+ * straight to a stream instead, in order with the rest of that stream's
+ * output. The command server uses this to return errors with each reply.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+using namespace std;
+
+class Log {
+public:
+  enum Severity { Debug, Info, Warning, Error, Off };
+
+  enum Message {
+    CustomerNotFound,
+    MovieNotFound,
+    OutOfStock,
+    TraceWriteFailed,
+    TransactionFailed,
+    UnknownGenre,
+    UnknownGenreCode,
+    UnknownTransactionCode,
+    UnknownTransactionType,
+    messageTypes
+  };
+
+  class Capture {
+  public:
+    Capture(ostream &);
+    ~Capture();
+
+  private:
+    ostream *previous;
+  };
+
+  static void write(Message, const string &detail = string());
+  static void write(Message, char);
+  static void setLevel(Severity);
+  static bool setLevel(const string &);
+  static void setRateLimit(int);
+  static long long count(Message);
+  static long long suppressed(Message);
+  static void flush();
+
+private:
+  struct Slot {
+    atomic<size_t> sequence;
+    Message message;
+    unsigned char length;
+    char detail[94];
+  };
+
+  struct Format {
+    const char *name;
+    Severity severity;
+    const char *before;
+    const char *after;
+  };
+
+  static const size_t capacity = 8192;
+  static const Format formats[messageTypes];
+
+  unique_ptr<Slot[]> slots;
+  atomic<size_t> enqueuePosition;
+  atomic<size_t> dequeuePosition;
+  atomic<int> level;
+  atomic<int> rateLimit;
+  atomic<long long> counts[messageTypes];
+  atomic<long long> suppressedCounts[messageTypes];
+  atomic<long long> unreported[messageTypes];
+  atomic<long long> windowStart[messageTypes];
+  atomic<int> windowCount[messageTypes];
+  atomic<size_t> writtenPosition;
+  atomic<bool> sleeping;
+  atomic<bool> stopping;
+  mutex wakeLock;
+  condition_variable wakeup;
+  condition_variable written;
+  thread writer;
+
+  Log();
+  static Log &instance();
+  static void format(string &, Message, const char *, size_t);
+  bool admit(Message);
+  void enqueue(Message, const char *, size_t);
+  bool dequeue(Message &, string &);
+  void wake();
+  void run();
+  ~Log();
+
+};
+#endif // LOG_H
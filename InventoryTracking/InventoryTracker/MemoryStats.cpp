@@ -0,0 +1,160 @@
+/**
+ * MemoryStats - a breakdown of the Store's memory by subsystem.
+ *
+ * Each data structure adds what it holds to a MemoryStats through its
+ * `accountMemory` method: the bytes of its records, nodes and buffers, and
+ * how many of them there are. Bytes are what the structures have asked
+ * for, not what the allocator rounded them up to, and a string only counts
+ * when its text is stored outside the string itself. The breakdown is taken
+ * when it is asked for, so keeping it costs nothing while commands run.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "MemoryStats.h"
+#include <fstream>
+#include <unistd.h>
+using namespace std;
+
+/**
+ * Constructs an empty breakdown.
+ */
+MemoryStats::MemoryStats()
+  : arenaUsed(0), arenaReserved(0) {
+}
+
+/**
+ * Adds memory to a subsystem.
+ *
+ * @param subsystem The subsystem the memory belongs to.
+ * @param bytes The number of bytes.
+ * @param objects The number of objects those bytes hold.
+ */
+void MemoryStats::add(Subsystem subsystem, long long bytes, long long objects) {
+  usage[subsystem].bytes += bytes;
+  usage[subsystem].objects += objects;
+}
+
+/**
+ * Adds an arena's blocks. Arenas hold records that are already counted
+ * under their subsystems, so they are shown separately and not totalled.
+ *
+ * @param used The bytes handed out by the arena.
+ * @param reserved The bytes of the arena's blocks.
+ */
+void MemoryStats::addArena(long long used, long long reserved) {
+  arenaUsed += used;
+  arenaReserved += reserved;
+}
+
+/**
+ * Returns the memory held by a subsystem.
+ *
+ * @param subsystem The subsystem.
+ * @return Its bytes and object count.
+ */
+MemoryStats::Usage MemoryStats::get(Subsystem subsystem) const {
+  return usage[subsystem];
+}
+
+/**
+ * Returns the memory held by all subsystems together.
+ *
+ * @return The total bytes and object count.
+ */
+MemoryStats::Usage MemoryStats::total() const {
+  Usage sum;
+
+  for(int i = 0; i < subsystems; i++) {
+    sum.bytes += usage[i].bytes;
+    sum.objects += usage[i].objects;
+  }
+
+  return sum;
+}
+
+/**
+ * Displays the breakdown as a table with a row per subsystem, the total,
+ * and the arenas' blocks.
+ *
+ * @param out The writer to display the table with.
+ */
+void MemoryStats::display(ReportWriter &out) const {
+  out.write("Memory Usage: ").endLine();
+  out.write("-----------------------------------------------------").endLine();
+  out.writePadded("Subsystem", 22).writePadded("Objects", 14).write("Bytes").endLine();
+
+  for(int i = 0; i < subsystems; i++) {
+    out.writePadded(getName(static_cast<Subsystem>(i)), 22)
+      .writePadded(to_string(usage[i].objects), 14)
+      .write(to_string(usage[i].bytes)).endLine();
+  }
+
+  Usage sum = total();
+  out.writePadded("Total", 22).writePadded(to_string(sum.objects), 14)
+    .write(to_string(sum.bytes)).endLine();
+  out.write("Arena blocks: ").write(to_string(arenaReserved)).write(" bytes reserved, ")
+    .write(to_string(arenaUsed)).write(" bytes used").endLine();
+
+  long long resident = residentBytes();
+  if(resident > 0) {
+    out.write("Resident set size: ").write(to_string(resident)).write(" bytes").endLine();
+  }
+}
+
+/**
+ * Returns the name a subsystem is displayed with.
+ *
+ * @param subsystem The subsystem.
+ * @return Its name.
+ */
+const char *MemoryStats::getName(Subsystem subsystem) {
+  const char *names[subsystems] = {
+    "Movie records", "Movie strings", "Movie stock", "Movie tree nodes", "Inventory reports",
+    "Customer records", "Customer table", "Customer histories",
+    "Transactions", "Command attributes", "Command latencies"
+  };
+
+  return names[subsystem];
+}
+
+/**
+ * Returns the bytes a string stores outside itself. Short strings are kept
+ * inside the string object and take no extra memory.
+ *
+ * @param text The string.
+ * @return The size of its separate buffer, or 0 if it has none.
+ */
+long long MemoryStats::heapBytes(const string &text) {
+  const char *data = text.data();
+  const char *object = reinterpret_cast<const char*>(&text);
+
+  if(data >= object && data < object + sizeof(string)) {
+    return 0;
+  }
+
+  return text.capacity() + 1;
+}
+
+/**
+ * Returns the process's resident set size, for comparison with the 
+ * breakdown.
+ *
+ * @return The resident bytes, or 0 if they cannot be read.
+ */
+long long MemoryStats::residentBytes() {
+  ifstream statm("/proc/self/statm");
+  long long totalPages = 0, residentPages = 0;
+
+  if(!(statm >> totalPages >> residentPages)) {
+    return 0;
+  }
+
+  return residentPages * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * Class Destructor
+ */
+MemoryStats::~MemoryStats() {}
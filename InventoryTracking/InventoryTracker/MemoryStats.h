@@ -0,0 +1,60 @@
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+
+/**
+ * MemoryStats - a breakdown of the Store's memory by subsystem.
+ *
+ * Each data structure adds what it holds to a MemoryStats through its
+ * `accountMemory` method: the bytes of its records, nodes and buffers, and
+ * how many of them there are. Bytes are what the structures have asked
+ * for, not what the allocator rounded them up to, and a string only counts
+ * when its text is stored outside the string itself. The breakdown is taken
+ * when it is asked for, so keeping it costs nothing while commands run.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "ReportWriter.h"
+#include <string>
+using namespace std;
+
+class MemoryStats {
+public:
+  enum Subsystem {
+    MovieRecords,
+    MovieStrings,
+    StockEntries,
+    TreeNodes,
+    InventoryReports,
+    CustomerRecords,
+    CustomerTable,
+    HistoryEntries,
+    Transactions,
+    CommandAttributes,
+    CommandLatencies,
+    subsystems
+  };
+
+  struct Usage {
+    long long bytes = 0;
+    long long objects = 0;
+  };
+
+  MemoryStats();
+  void add(Subsystem, long long, long long objects = 1);
+  void addArena(long long, long long);
+  Usage get(Subsystem) const;
+  Usage total() const;
+  void display(ReportWriter &) const;
+  static const char *getName(Subsystem);
+  static long long heapBytes(const string &);
+  static long long residentBytes();
+  ~MemoryStats();
+
+private:
+  Usage usage[subsystems];
+  long long arenaUsed;
+  long long arenaReserved;
+};
+#endif // MEMORYSTATS_H
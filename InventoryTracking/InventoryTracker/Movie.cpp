@@ -6,11 +6,16 @@
  * characteristics while potentially adding genre-specific features
  * and behaviors.
  *
+ * The title, director and other names are interned in a StringPool shared
+ * by the movies of a Store and held here as integer handles, so movies 
+ * with the same names store them once and compare them as integers.
+ *
  * Nolan Dela Rosa
  *
  * August 9, 2024
  */
 #include "Movie.h"
+#include "StockTable.h"
 using namespace std;
 
 /**
@@ -18,7 +23,7 @@ using namespace std;
  * Initializes a new instance of the Movie class with default values.
  */
 Movie::Movie()
-  : genre(' '), stock(0), yearReleased(0), title(""), director("") {
+  : genre(' '), yearReleased(0), title(-1), director(-1), names(nullptr) {
 }
 
 /**
@@ -26,46 +31,89 @@ Movie::Movie()
  * Initializes a new instance of the Movie class with specified values.
  *
  * @param type The genre of the movie.
- * @param theStock The number of copies available in stock.
- * @param theTitle The title of the movie.
- * @param theDirector The director of the movie.
+ * @param theDirector The handle of the director's name in the pool.
+ * @param theTitle The handle of the title in the pool.
  * @param theYear The year the movie was released.
+ * @param theNames The pool the handles belong to.
  */
-Movie::Movie(char type, int theStock, const string &theDirector,
-  const string &theTitle, int theYear) 
-    : genre(type), stock(theStock), director(theDirector),
-      title(theTitle), yearReleased(theYear) {
+Movie::Movie(char type, int theDirector, int theTitle, int theYear,
+  const StringPool *theNames) 
+    : genre(type), yearReleased(theYear), title(theTitle),
+      director(theDirector), names(theNames) {
 }
 
 /**
  * Class copy constructor
+ * The copy reads its stock count from the same StockTable entry.
  */
 Movie::Movie(const Movie &other) 
-  : genre(other.genre), stock(other.stock), director(other.director),
-    title(other.title), yearReleased(other.yearReleased) {
+  : genre(other.genre), yearReleased(other.yearReleased),
+    title(other.title), director(other.director), names(other.names),
+    stockTable(other.stockTable), stockId(other.stockId) {
 }
 
 /**
- * Increments the stock count of the movie by one when the movie is returned.
- * This method should be called to update the inventory whenever a movie 
- * that was previously checked out is returned, making it available again.
+ * Registers the inventory cache whose row shows this movie, so the row 
+ * can be marked stale whenever the stock changes. Only a movie whose stock
+ * is kept in a StockTable can be watched.
+ *
+ * @param cache The cache to tell, or nullptr to stop watching.
+ * @param row This movie's row in the cache.
  */
-void Movie::returnMovie() {
-  stock++;
+void Movie::watchStock(InventoryCache *cache, size_t row) const {
+  if(stockTable != nullptr) {
+    stockTable->watch(stockId, cache, row);
+  }
 }
 
 /**
- * Decreases the stock count of the movie by one when the movie is borrowed.
- * This method should be called to update the inventory whenever a movie is 
- * checked out or borrowed, reducing its availability.
+ * Records that this movie's stock count is now kept in a StockTable. 
+ * Called by `StockTable::add`.
+ *
+ * @param table The table holding the stock count.
+ * @param id This movie's stock ID in the table.
  */
-void Movie::borrowMovie() {
-  if(stock < 0) {
-    cout << "Error: this Movie is out of stock." << endl;
-    return;
-  }
+void Movie::attachStock(StockTable *table, unsigned id) {
+  stockTable = table;
+  stockId = id;
+}
+
+/**
+ * Returns the table holding this movie's stock count.
+ *
+ * @return The StockTable, or nullptr if the movie is not in a table.
+ */
+StockTable *Movie::getStockTable() const {
+  return stockTable;
+}
+
+/**
+ * Returns this movie's stock ID in its StockTable.
+ *
+ * @return The stock ID; meaningless if the movie is not in a table.
+ */
+unsigned Movie::getStockId() const {
+  return stockId;
+}
 
-  stock--;
+/**
+ * Displays this movie's information with its current stock count.
+ */
+void Movie::displayInfo() const {
+  ReportWriter::StreamSink console(cout);
+  ReportWriter out(console);
+  displayInfo(out, getStock());
+}
+
+/**
+ * Reports whether a movie with the given stock count can no longer be 
+ * borrowed.
+ *
+ * @param stockCount A stock count.
+ * @return true if a borrow at this stock count must be refused.
+ */
+bool Movie::isOutOfStock(int stockCount) {
+  return stockCount < 0;
 }
 
 /**
@@ -80,10 +128,11 @@ char Movie::getGenre() const {
 /**
  * Retrieves the current stock quantity of this Movie instance.
  *
- * @return The number of available copies of the movie in stock.
+ * @return The number of available copies of the movie in stock, or 0 if
+ *   the movie is not in a StockTable.
  */
 int Movie::getStock() const {
-  return stock;
+  return stockTable != nullptr ? stockTable->get(stockId) : 0;
 }
 
 /**
@@ -91,8 +140,8 @@ int Movie::getStock() const {
  *
  * @return The title of the movie as a string.
  */
-string Movie::getTitle() const {
-  return title;
+const string &Movie::getTitle() const {
+  return getName(title);
 }
 
 /**
@@ -100,8 +149,8 @@ string Movie::getTitle() const {
  *
  * @return The director's name as a string.
  */
-string Movie::getDirector() const {
-  return director;
+const string &Movie::getDirector() const {
+  return getName(director);
 }
 
 /**
@@ -113,6 +162,17 @@ int Movie::getYearReleased() const {
   return yearReleased;
 }
 
+/**
+ * Retrieves one of this movie's names from its pool.
+ *
+ * @param handle The handle of the name, or -1 if the movie has none.
+ * @return The name, or an empty string if it is not set.
+ */
+const string &Movie::getName(int handle) const {
+  static const string none;
+  return names != nullptr && handle >= 0 ? names->get(handle) : none;
+}
+
 /**
  * Class Destructor
  */
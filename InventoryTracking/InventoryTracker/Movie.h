@@ -8,38 +8,59 @@
  * characteristics while potentially adding genre-specific features
  * and behaviors.
  *
+ * The title, director and other names are interned in a StringPool shared
+ * by the movies of a Store and held here as integer handles, so movies 
+ * with the same names store them once and compare them as integers.
+ *
  * Nolan Dela Rosa
  *
  * August 9, 2024
  */
+#include "ReportWriter.h"
+#include "MemoryStats.h"
+#include "StringPool.h"
 #include <string>
 #include <iostream>
 #include <iomanip>
 using namespace std;
 
+class InventoryCache;
+class StockTable;
+
 class Movie {
 protected:
   char genre;
-  int stock;
   int yearReleased;
-  string title;
-  string director;
+  int title;                  // handles of the names in the pool below
+  int director;
+  const StringPool *names;    // the pool holding this movie's names
+
+  const string &getName(int) const;
+
+private:
+  StockTable *stockTable = nullptr;   // holds the stock count
+  unsigned stockId = 0;               // this movie's entry in that table
 
 public:
   Movie();
-  Movie(char, int, const string &, const string &, int);
+  Movie(char, int, int, int, const StringPool *);
   Movie(const Movie &);
-  virtual void displayInfo() const = 0;
+  virtual void displayInfo() const;
+  virtual void displayInfo(ReportWriter &, int) const = 0;
   virtual Movie &operator=(const Movie &) = 0;
   virtual bool operator==(const Movie &) const = 0;
   virtual bool operator!=(const Movie &) const = 0;
   virtual bool operator<(const Movie &) const = 0;
   virtual bool operator>(const Movie &) const = 0;
-  virtual void borrowMovie();
-  virtual void returnMovie();
+  static bool isOutOfStock(int);
+  void watchStock(InventoryCache *, size_t) const;
+  void attachStock(StockTable *, unsigned);
+  StockTable *getStockTable() const;
+  unsigned getStockId() const;
+  virtual void accountMemory(MemoryStats &) const = 0;
   virtual char getGenre() const;
-  virtual string getTitle() const;
-  virtual string getDirector() const;
+  virtual const string &getTitle() const;
+  virtual const string &getDirector() const;
   virtual int getStock() const;
   virtual int getYearReleased() const;
   virtual ~Movie();
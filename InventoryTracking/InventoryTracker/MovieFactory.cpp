@@ -17,27 +17,39 @@ using namespace std;
  * If the type is unrecognized, an error message is printed and nullptr is returned.
  *
  * @param type The genre type of the movie ('C' for Classic, 'D' for Drama, 'F' for Comedy).
- * @param theStock The initial stock quantity of the movie.
  * @param theDirector The director of the movie.
  * @param theTitle The title of the movie.
  * @param actor The lead actor (used only for Classic movies).
  * @param month The release month (used only for Classic movies).
  * @param year The release year of the movie.
+ * @param names The pool to intern the movie's names in.
+ * @param arena The arena to create the movie in, or nullptr to use the heap.
  * @return A pointer to the newly created Movie object, or nullptr if the genre type is invalid.
  */
-Movie* MovieFactory::createMovie(char type, int theStock, const string &theDirector,
-  const string &theTitle, const string &actor, int month, int year) {
+Movie* MovieFactory::createMovie(char type, const string &theDirector,
+  const string &theTitle, const string &actor, int month, int year, StringPool &names, 
+  Arena *arena) {
     if(type == 'C') {
-      return new Classic(type, theStock, theDirector, theTitle, actor, month, year);
+      int director = names.intern(theDirector), title = names.intern(theTitle);
+      int majorActor = names.intern(actor);
+      return arena != nullptr 
+        ? arena->create<Classic>(type, director, title, majorActor, month, year, &names)
+        : new Classic(type, director, title, majorActor, month, year, &names);
 
     } else if(type == 'D') {
-        return new Drama(type, theStock, theDirector, theTitle, year);
+        int director = names.intern(theDirector), title = names.intern(theTitle);
+        return arena != nullptr 
+          ? arena->create<Drama>(type, director, title, year, &names)
+          : new Drama(type, director, title, year, &names);
 
     } else if(type == 'F') {
-        return new Comedy(type, theStock, theDirector, theTitle, year);
+        int director = names.intern(theDirector), title = names.intern(theTitle);
+        return arena != nullptr 
+          ? arena->create<Comedy>(type, director, title, year, &names)
+          : new Comedy(type, director, title, year, &names);
 
     } else {
-        cout << "Error: unknown genre " << type << "." << endl;
+        Log::write(Log::UnknownGenre, type);
         return nullptr;
     }
   }
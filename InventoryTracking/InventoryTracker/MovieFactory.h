@@ -14,11 +14,13 @@
 #include "Classic.h"
 #include "Comedy.h"
 #include "Drama.h"
+#include "Log.h"
+#include "Arena.h"
 using namespace std;
 
 class MovieFactory {
 public:
-  static Movie* createMovie(char, int, const string &,
-    const string &, const string &, int, int);
+  static Movie* createMovie(char, const string &,
+    const string &, const string &, int, int, StringPool &, Arena *arena = nullptr);
 };
 #endif // MOVIEFACTORY_H
\ No newline at end of file
@@ -16,9 +16,14 @@ using namespace std;
  * Initializes the binary tree with no nodes, setting
  * the root to nullptr. This creates an empty tree
  * that can have nodes added to it later.
+ *
+ * @param theArena The arena to create nodes in, or nullptr to use the heap.
+ *                 A tree with an arena never frees its nodes or movies;
+ *                 they are destroyed when the arena is released, so its 
+ *                 movies must come from the same arena.
  */
-MovieTree::MovieTree() 
-  : root(nullptr) { 
+MovieTree::MovieTree(Arena *theArena) 
+  : root(nullptr), arena(theArena) { 
 }
 
 /**
@@ -49,7 +54,7 @@ bool MovieTree::insert(Movie *value) {
  */
 bool MovieTree::insertInMovieTree(Node *&current, Movie *value) {
   if (current == nullptr) {
-    current = new Node;
+    current = arena != nullptr ? arena->create<Node>() : new Node;
     current->data = value;
     return true;
 
@@ -111,7 +116,19 @@ bool MovieTree::find(Node *current, const Movie &target, Movie *&found) const {
  * Uses inorder traversal to print nodes in sorted order.
  */
 void MovieTree::display() const {
-  displayHelper(root);
+  ReportWriter::StreamSink console(cout);
+  ReportWriter out(console);
+  display(out);
+}
+
+/**
+ * Formats the contents of the MovieTree into a report writer.
+ * Uses inorder traversal to write nodes in sorted order.
+ *
+ * @param out The writer to format the movies into.
+ */
+void MovieTree::display(ReportWriter &out) const {
+  displayHelper(root, out);
 }
 
 /**
@@ -120,12 +137,62 @@ void MovieTree::display() const {
  * in sorted order.
  * 
  * * @param current The current node in the traversal.
+ * @param out The writer to format the movies into.
  */
-void MovieTree::displayHelper(Node *current) const {
+void MovieTree::displayHelper(Node *current, ReportWriter &out) const {
   if(current != nullptr) {
-    displayHelper(current->left);
-    current->data->displayInfo();
-    displayHelper(current->right);
+    displayHelper(current->left, out);
+    current->data->displayInfo(out, current->data->getStock());
+    displayHelper(current->right, out);
+  }
+}
+
+/**
+ * Appends every movie in the MovieTree to a list, in the sorted order 
+ * that `display` prints them in.
+ *
+ * @param movies The list to append the movies to.
+ */
+void MovieTree::collect(vector<const Movie*> &movies) const {
+  collectHelper(root, movies);
+}
+
+/**
+ * Recursively performs an inorder traversal of the MovieTree starting 
+ * from the given node, appending each node's movie to a list.
+ *
+ * @param current The current node in the traversal.
+ * @param movies The list to append the movies to.
+ */
+void MovieTree::collectHelper(Node *current, vector<const Movie*> &movies) const {
+  if(current != nullptr) {
+    collectHelper(current->left, movies);
+    movies.push_back(current->data);
+    collectHelper(current->right, movies);
+  }
+}
+
+/**
+ * Adds the memory of the tree's nodes and movies to a breakdown.
+ *
+ * @param stats The breakdown to add to.
+ */
+void MovieTree::accountMemory(MemoryStats &stats) const {
+  accountHelper(root, stats);
+}
+
+/**
+ * Recursively adds the memory of the subtree rooted at the given node.
+ *
+ * @param current The root of the subtree.
+ * @param stats The breakdown to add to.
+ */
+void MovieTree::accountHelper(Node *current, MemoryStats &stats) const {
+  if(current != nullptr) {
+    stats.add(MemoryStats::TreeNodes, sizeof(Node));
+    current->data->accountMemory(stats);
+    accountHelper(current->left, stats);
+    accountHelper(current->right, stats);
   }
 }
 
@@ -138,17 +205,21 @@ void MovieTree::makeEmpty() {
 }
 
 /**
- * Recursively clears the MovieTree by deallocating all nodes.
+ * Recursively clears the MovieTree by deallocating all nodes. Nodes and 
+ * movies in an arena are left for the arena to release.
  *
  * @param current The current node being cleared.
  */
 void MovieTree::clear(Node *&current) {
-  if (current != nullptr) {
-    clear(current->left);
-    clear(current->right);
-    delete current->data;
-    delete current;
+  if (arena != nullptr) {
     current = nullptr;
+
+  } else if (current != nullptr) {
+      clear(current->left);
+      clear(current->right);
+      delete current->data;
+      delete current;
+      current = nullptr;
   }
 }
 
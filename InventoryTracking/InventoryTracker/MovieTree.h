@@ -15,6 +15,7 @@
 #include "Classic.h"
 #include "Comedy.h"
 #include "Drama.h"
+#include "Arena.h"
 #include <iostream>
 using namespace std;
 
@@ -26,17 +27,23 @@ private:
     Node* right = nullptr;
   };
   Node* root;
+  Arena *arena;
   bool insertInMovieTree(Node *&, Movie *);
   bool find(Node *, const Movie &, Movie *&) const;
-  void displayHelper(Node *) const;
+  void displayHelper(Node *, ReportWriter &) const;
+  void collectHelper(Node *, vector<const Movie*> &) const;
+  void accountHelper(Node *, MemoryStats &) const;
   void clear(Node *&);
 
 public:
-  MovieTree();
+  MovieTree(Arena *theArena = nullptr);
   ~MovieTree();
   bool insert(Movie*);
   bool retrieve(const Movie &, Movie *&) const;
   void display() const;
+  void display(ReportWriter &) const;
+  void collect(vector<const Movie*> &) const;
+  void accountMemory(MemoryStats &) const;
   void makeEmpty();
 };
 
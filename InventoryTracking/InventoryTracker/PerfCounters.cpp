@@ -0,0 +1,291 @@
+/**
+ * PerfCounters - hardware performance counters of the calling thread, read
+ * through perf_event_open, for judging changes to the Store's data layout
+ * by more than wall time.
+ *
+ * A PerfCounters counts the instructions, cycles, last-level cache misses
+ * and branch mispredictions of the thread that created it, in user space
+ * only. Each counter is opened on its own, so one the processor or kernel
+ * does not offer is reported as unavailable while the others still count;
+ * in containers and virtual machines there are often none at all, and 
+ * then every reading is empty and the reason is kept for reports.
+ *
+ * A Phase adds what the counters moved during its scope to a total kept 
+ * under its name. Phases only read the counters while phase counting is 
+ * on, and each reads the counters of the thread it runs on, so work a 
+ * phase hands to other threads is not included. Phases may nest, and a 
+ * nested phase is also counted in the phase around it. A Recording turns 
+ * phase counting on and prints the totals when it is destroyed.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "PerfCounters.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+using namespace std;
+
+atomic<bool> PerfCounters::phasesCounted(false);
+mutex PerfCounters::phasesLock;
+map<string, PerfCounters::PhaseTotal> PerfCounters::phases;
+
+/**
+ * Constructs an empty reading, with every counter unavailable.
+ */
+PerfCounters::Reading::Reading() {
+  for(int i = 0; i < events; i++) {
+    values[i] = -1;
+  }
+}
+
+/**
+ * Adds another reading's counts to this one. A counter stays unavailable 
+ * only if it is unavailable in both.
+ *
+ * @param other The reading to add.
+ * @return This reading.
+ */
+PerfCounters::Reading &PerfCounters::Reading::operator+=(const Reading &other) {
+  for(int i = 0; i < events; i++) {
+    if(other.values[i] >= 0) {
+      values[i] = max(values[i], 0LL) + other.values[i];
+    }
+  }
+
+  return *this;
+}
+
+/**
+ * Returns how far each counter moved since an earlier reading.
+ *
+ * @param earlier The earlier reading.
+ * @return The differences; unavailable where either reading is.
+ */
+PerfCounters::Reading PerfCounters::Reading::operator-(const Reading &earlier) const {
+  Reading difference;
+
+  for(int i = 0; i < events; i++) {
+    if(values[i] >= 0 && earlier.values[i] >= 0) {
+      difference.values[i] = values[i] - earlier.values[i];
+    }
+  }
+
+  return difference;
+}
+
+/**
+ * Returns the instructions retired per cycle.
+ *
+ * @return The IPC, or -1 if either counter is unavailable or no cycles 
+ *         were counted.
+ */
+double PerfCounters::Reading::ipc() const {
+  if(values[Instructions] < 0 || values[Cycles] <= 0) {
+    return -1;
+  }
+
+  return double(values[Instructions]) / values[Cycles];
+}
+
+/**
+ * Starts a phase, reading this thread's counters if phases are counted.
+ *
+ * @param theName The phase's name.
+ */
+PerfCounters::Phase::Phase(const char *theName)
+  : name(theName), counting(phasesCounted.load(memory_order_relaxed)) {
+  if(counting) {
+    started = forThisThread().read();
+  }
+}
+
+/**
+ * Class Destructor
+ * Ends the phase, adding what the counters moved to its total.
+ */
+PerfCounters::Phase::~Phase() {
+  if(counting) {
+    Reading moved = forThisThread().read() - started;
+    lock_guard<mutex> guard(phasesLock);
+    PhaseTotal &total = phases[name];
+    total.runs++;
+    total.counts += moved;
+  }
+}
+
+/**
+ * Turns phase counting on, if enabled, until the Recording is destroyed.
+ *
+ * @param isEnabled Whether to count phases at all.
+ * @param theOut The stream to print the totals to.
+ */
+PerfCounters::Recording::Recording(bool isEnabled, ostream &theOut)
+  : enabled(isEnabled), out(theOut) {
+  if(enabled) {
+    phasesCounted.store(true, memory_order_relaxed);
+  }
+}
+
+/**
+ * Class Destructor
+ * Turns phase counting off and prints the totals, if it was enabled.
+ */
+PerfCounters::Recording::~Recording() {
+  if(enabled) {
+    phasesCounted.store(false, memory_order_relaxed);
+    display(out);
+  }
+}
+
+/**
+ * Opens the counters for the calling thread. Counters that cannot be 
+ * opened are left unavailable, and the reason the first one failed is 
+ * kept.
+ */
+PerfCounters::PerfCounters() {
+  const unsigned long long configs[events] = {
+    PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, 
+    PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+  };
+
+  for(int i = 0; i < events; i++) {
+    perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = configs[i];
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    descriptors[i] = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+
+    if(descriptors[i] < 0 && error.empty()) {
+      error = string("perf_event_open: ") + strerror(errno);
+    }
+  }
+}
+
+/**
+ * Reports whether any counter could be opened.
+ *
+ * @return true if at least one counter is counting.
+ */
+bool PerfCounters::isAvailable() const {
+  for(int i = 0; i < events; i++) {
+    if(descriptors[i] >= 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Returns why a counter could not be opened.
+ *
+ * @return The first failure, or an empty string if every counter opened.
+ */
+const string &PerfCounters::getError() const {
+  return error;
+}
+
+/**
+ * Reads the counters. When the kernel had to share the hardware between 
+ * more counters than it has, each count is scaled up to the time its 
+ * counter was enabled.
+ *
+ * @return The counts since the counters were opened.
+ */
+PerfCounters::Reading PerfCounters::read() const {
+  Reading reading;
+
+  for(int i = 0; i < events; i++) {
+    unsigned long long value[3];   // count, time enabled, time running
+
+    if(descriptors[i] < 0 || ::read(descriptors[i], value, sizeof(value)) != sizeof(value)) {
+      continue;
+    }
+
+    reading.values[i] = value[2] == 0 ? 0 
+      : (long long)((double)value[0] * value[1] / value[2]);
+  }
+
+  return reading;
+}
+
+/**
+ * Prints the totals of every phase counted so far: runs, instructions, 
+ * cycles, IPC, last-level cache misses and branch mispredictions, or why
+ * the counters are unavailable.
+ *
+ * @param out The stream to print to.
+ */
+void PerfCounters::display(ostream &out) {
+  PerfCounters &counters = forThisThread();
+
+  if(!counters.isAvailable()) {
+    out << "Hardware counters unavailable (" << counters.getError() << ")." << endl;
+    return;
+  }
+
+  char line[160];
+  out << "Hardware counters by phase (user space, the phase's own thread):" << endl;
+  snprintf(line, sizeof(line), "%-20s %6s %16s %16s %6s %14s %14s", "Phase", "Runs",
+    "Instructions", "Cycles", "IPC", "LLC misses", "Branch misses");
+  out << line << endl;
+
+  lock_guard<mutex> guard(phasesLock);
+  for(const auto &phase : phases) {
+    const Reading &counts = phase.second.counts;
+    double ipc = counts.ipc();
+
+    snprintf(line, sizeof(line), "%-20s %6lld %16s %16s %6s %14s %14s", phase.first.c_str(),
+      phase.second.runs, format(counts.values[Instructions]).c_str(), 
+      format(counts.values[Cycles]).c_str(), ipc < 0 ? "n/a" : to_string(ipc).substr(0, 4).c_str(),
+      format(counts.values[CacheMisses]).c_str(), format(counts.values[BranchMisses]).c_str());
+    out << line << endl;
+  }
+
+  if(!counters.getError().empty()) {
+    out << "Some counters are unavailable (" << counters.getError() << ")." << endl;
+  }
+}
+
+/**
+ * Returns the calling thread's counters, opening them the first time.
+ *
+ * @return The counters.
+ */
+PerfCounters &PerfCounters::forThisThread() {
+  thread_local PerfCounters counters;
+  return counters;
+}
+
+/**
+ * Formats a count for the phase table.
+ *
+ * @param count The count, or -1 if unavailable.
+ * @return The count as text, or "n/a".
+ */
+string PerfCounters::format(long long count) {
+  return count < 0 ? "n/a" : to_string(count);
+}
+
+/**
+ * Class Destructor
+ * Closes the counters.
+ */
+PerfCounters::~PerfCounters() {
+  for(int i = 0; i < events; i++) {
+    if(descriptors[i] >= 0) {
+      close(descriptors[i]);
+    }
+  }
+}
@@ -0,0 +1,90 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+/**
+ * PerfCounters - hardware performance counters of the calling thread, read
+ * through perf_event_open, for judging changes to the Store's data layout
+ * by more than wall time.
+ *
+ * A PerfCounters counts the instructions, cycles, last-level cache misses
+ * and branch mispredictions of the thread that created it, in user space
+ * only. Each counter is opened on its own, so one the processor or kernel
+ * does not offer is reported as unavailable while the others still count;
+ * in containers and virtual machines there are often none at all, and 
+ * then every reading is empty and the reason is kept for reports.
+ *
+ * A Phase adds what the counters moved during its scope to a total kept 
+ * under its name. Phases only read the counters while phase counting is 
+ * on, and each reads the counters of the thread it runs on, so work a 
+ * phase hands to other threads is not included. Phases may nest, and a 
+ * nested phase is also counted in the phase around it. A Recording turns 
+ * phase counting on and prints the totals when it is destroyed.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+using namespace std;
+
+class PerfCounters {
+public:
+  enum Event { Instructions, Cycles, CacheMisses, BranchMisses, events };
+
+  struct Reading {
+    long long values[events];   // -1 where the counter is unavailable
+    Reading();
+    Reading &operator+=(const Reading &);
+    Reading operator-(const Reading &) const;
+    double ipc() const;
+  };
+
+  class Phase {
+  public:
+    Phase(const char *);
+    ~Phase();
+
+  private:
+    const char *name;
+    bool counting;
+    Reading started;
+  };
+
+  class Recording {
+  public:
+    Recording(bool, ostream &);
+    ~Recording();
+
+  private:
+    bool enabled;
+    ostream &out;
+  };
+
+  PerfCounters();
+  bool isAvailable() const;
+  const string &getError() const;
+  Reading read() const;
+  static void display(ostream &);
+  ~PerfCounters();
+
+private:
+  struct PhaseTotal {
+    long long runs = 0;
+    Reading counts;
+  };
+
+  int descriptors[events];
+  string error;
+
+  static atomic<bool> phasesCounted;
+  static mutex phasesLock;
+  static map<string, PhaseTotal> phases;
+
+  static PerfCounters &forThisThread();
+  static string format(long long);
+};
+#endif // PERFCOUNTERS_H
@@ -0,0 +1,84 @@
+#ifndef REPORTWRITER_H
+#define REPORTWRITER_H
+
+/**
+ * ReportWriter - a buffered writer for formatted reports.
+ *
+ * Rows are formatted straight into a large preallocated buffer, with 
+ * padding done by hand instead of through iostream manipulators, and 
+ * nothing is written out until the buffer is full or the writer is 
+ * flushed, so a whole report costs one write per buffer instead of one 
+ * flush per row. Padded fields match `left << setw(width)` exactly: the 
+ * value is followed by spaces up to the width, and is never truncated.
+ * 
+ * The output goes to a Sink: a file descriptor (a file, pipe or blocking
+ * socket), an ostream, or a string.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+class ReportWriter {
+public:
+  class Sink {
+  public:
+    virtual bool write(const char *, size_t) = 0;
+    virtual ~Sink();
+  };
+
+  class DescriptorSink : public Sink {
+  public:
+    DescriptorSink(int);
+    bool write(const char *, size_t) override;
+
+  private:
+    int descriptor;
+  };
+
+  class StreamSink : public Sink {
+  public:
+    StreamSink(ostream &);
+    bool write(const char *, size_t) override;
+
+  private:
+    ostream &out;
+  };
+
+  class StringSink : public Sink {
+  public:
+    StringSink(string &);
+    bool write(const char *, size_t) override;
+
+  private:
+    string &target;
+  };
+
+  static const size_t defaultCapacity = 1 << 16;
+
+  ReportWriter(Sink &, size_t capacity = defaultCapacity);
+  ReportWriter &write(const string &);
+  ReportWriter &write(const char *);
+  ReportWriter &write(char);
+  ReportWriter &write(int);
+  ReportWriter &writePadded(const string &, size_t);
+  ReportWriter &writePadded(char, size_t);
+  ReportWriter &writePadded(int, size_t);
+  ReportWriter &endLine();
+  bool flush();
+  ~ReportWriter();
+
+private:
+  Sink &sink;
+  vector<char> buffer;
+  size_t used;
+  bool failed;
+
+  ReportWriter &write(const char *, size_t);
+  ReportWriter &pad(size_t, size_t);
+};
+#endif // REPORTWRITER_H
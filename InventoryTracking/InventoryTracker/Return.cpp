@@ -1,103 +1,112 @@
 /**
- * Borrow - a subclass of Transaction that represents a transaction for borrowing a movie.
- * This class is derived from the base Transaction class and is used to manage and track
- * the process of borrowing movies. It extends the functionality of the base class by 
- * implementing the `execute` method, which updates the state of the `HashTable` to reflect
- * that a movie has been borrowed, including decreasing its available stock.
+ * Return - executes transactions for returning a movie.
+ * This class is used to manage and track the process of returning movies. 
+ * Its `execute` method takes a prepared return Transaction, whose customer 
+ * and movie were resolved when it was parsed, and updates their state to 
+ * reflect that a movie has been returned, including increasing its available stock.
  *
  * Nolan Dela Rosa
  * 
  * August 13, 2024
  */
 #include "Return.h"
-#include <sstream>
 using namespace std;
 
 /**
- * Default constructor for the Return class.
- * This constructor provides a starting point for creating
- * Return objects before setting specific attributes.
+ * Executes the returning transaction using the customer and movie resolved when it was prepared.
+ * 
+ * If both were found, the function marks the movie as returned and 
+ * logs this transaction under the customer's record. If either is missing
+ * (e.g., customer or movie not found), appropriate error messages are logged.
+ * 
+ * @param transaction The prepared return Transaction to execute.
  */
-Return::Return() 
-  : Transaction(), mediaType(' '),
-    attribute1(" "), attribute2(" ") {
+void Return::execute(const Transaction &transaction) {
+  Customer::HistoryEntry entry;
+  bool succeeded = apply(transaction, entry);
+  record(transaction, succeeded, entry);
 }
 
 /**
- * Parameterized constructor for the Return class.
- * 
- * Initializes a new Return object with the provided values:
+ * Updates the stock of the movie a return transaction was resolved to and
+ * builds the history entry to record for it, without printing anything or
+ * touching the customer. Only the resolved movie is modified, so returns of
+ * movies in different genres can be applied concurrently.
  * 
- * @param trans The transaction type identifier, typically a character representing the type of transaction
- * @param ID The unique ID number of the customer making the transaction.
- * @param media A character representing the type of media being returned 
- * @param genreType A character representing the genre of the media 
- * @param data1 A string containing the first additional attribute relevant to the transaction 
- * @param data2 A string containing the second additional attribute relevant to the transaction (e.g., year of release, director's name).
+ * @param transaction The prepared return Transaction to apply.
+ * @param entry Receives the history entry for the customer's record.
+ * @return true if the movie was returned; false if the transaction is not 
+ *         resolved.
  */
-Return::Return(char trans, int ID, char media,
-  char genreType, const string &data1, const string &data2)
-  : Transaction(trans, genreType, ID), mediaType(media),
-    attribute1(data1), attribute2(data2) {
+bool Return::apply(const Transaction &transaction, Customer::HistoryEntry &entry) {
+  if(!transaction.isResolved()) {
+    return false;
+  }
+
+  transaction.getStockTable()->giveBack(transaction.getStockId());
+  entry = describe(transaction);
+  return true;
 }
 
 /**
- * Executes the returning transaction by processing the provided customer and movie data.
- * 
- * If the movie is found, the function attempts to mark the movie as borrowed and 
- * logs this transaction under the customer's record. If any step fails 
- * (e.g., movie not found, borrowing issue), appropriate error messages are displayed.
+ * Reports the outcome of an applied return transaction and logs it under the
+ * customer's record. Missing customers or movies produce the appropriate 
+ * error messages. Records for a customer must be made in the original 
+ * transaction order to keep their history correct.
  * 
- * @param movies The `MovieTree` object containing the collection of movies to search through.
- * @param customers The `HashTable` object containing the customer records to retrieve 
- *                  the customer details.
+ * @param transaction The prepared return Transaction that was applied.
+ * @param succeeded The result of `apply` for the transaction.
+ * @param entry The history entry built by `apply`.
  */
-void Return::execute(MovieTree &movies, HashTable &customers) {
-  Customer* currentCustomer = customers.get(customerID);
-
-  if(currentCustomer == nullptr) {
-    cout << "Error: customer not found!" << endl;
+void Return::record(const Transaction &transaction, bool succeeded, 
+  const Customer::HistoryEntry &entry) {
+  if(!report(transaction, succeeded)) {
     return;
   }
 
-  Movie* customerMovie = nullptr;
-  bool movieRetrieved = false;
-
-  if(genreOfMovie == 'C') {
-    int month = 0, year = 0;
-    istringstream releaseData(attribute1);
-    releaseData >> month >> year;
-    movieRetrieved = movies.retrieve(Classic(genreOfMovie, 0, "", "", 
-      attribute2, month, year), customerMovie);
+  Customer* currentCustomer = transaction.getCustomer();
 
-  } else if(genreOfMovie == 'D') {
-      movieRetrieved = movies.retrieve(Drama(genreOfMovie, 0,
-        attribute1, attribute2, 0), customerMovie);
+  try {
+    currentCustomer->addTransaction(entry);
 
-  } else if(genreOfMovie == 'F') {
-      int year = 0;
-      istringstream releaseYear(attribute2);
-      releaseYear >> year;
-      movieRetrieved = movies.retrieve(Comedy(genreOfMovie, 0,
-        "", attribute1, year), customerMovie);
+  } catch(const exception &e) {
+      Log::write(Log::TransactionFailed);
   }
+}
 
-  if(!movieRetrieved) {
-    cout << "Error: movie not found!" << endl;
-    return;
+/**
+ * Logs the error messages for the outcome of an applied return transaction:
+ * a missing customer or movie. Nothing is 
+ * logged for a successful return.
+ * 
+ * @param transaction The prepared return Transaction that was applied.
+ * @param succeeded The result of `apply` for the transaction; unused, as a
+ *                  resolved return cannot fail.
+ * @return true if the transaction should be logged under the customer's 
+ *         record; false if its customer or movie was not found.
+ */
+bool Return::report(const Transaction &transaction, bool /* succeeded */) {
+  if(transaction.getCustomer() == nullptr) {
+    Log::write(Log::CustomerNotFound);
+    return false;
   }
 
-  try {
-    customerMovie->returnMovie();
-    currentCustomer->addTransaction("Returned " 
-      + customerMovie->getTitle());
-
-  } catch(const exception &e) {
-      cout << "Error: transaction unsuccessful!" << endl;
+  if(transaction.getMovie() == nullptr) {
+    Log::write(Log::MovieNotFound);
+    return false;
   }
+
+  return true;
 }
 
 /**
- * Class Destructor
+ * Builds the history entry logged for a resolved return transaction.
+ * 
+ * @param transaction A return Transaction whose movie was resolved.
+ * @return The entry to add to the customer's record, referring to the 
+ *         movie's interned title.
  */
-Return::~Return() {}
\ No newline at end of file
+Customer::HistoryEntry Return::describe(const Transaction &transaction) {
+  return Customer::HistoryEntry(Customer::HistoryEntry::Returned, 
+    &transaction.getMovie()->getTitle());
+}
@@ -2,33 +2,29 @@
 #define RETURN_H
 
 /**
- * Borrow - a subclass of Transaction that represents a transaction for returning a movie.
- * This class is derived from the base Transaction class and is used to manage and track
- * the process of returning movies. It extends the functionality of the base class by 
- * implementing the `execute` method, which updates the state of the `HashTable` to reflect
- * that a movie has been returned, including increasing its available stock.
+ * Return - executes transactions for returning a movie.
+ * This class is used to manage and track the process of returning movies. 
+ * Its `execute` method takes a prepared return Transaction, whose customer 
+ * and movie were resolved when it was parsed, and updates their state to 
+ * reflect that a movie has been returned, including increasing its available stock.
  *
  * Nolan Dela Rosa
  * 
  * August 13, 2024
  */
 #include "Transaction.h"
-#include "MovieTree.h"
-#include "Classic.h"
-#include "Comedy.h"
-#include "Drama.h"
+#include "Customer.h"
+#include "Movie.h"
+#include "StockTable.h"
+#include "Log.h"
 using namespace std;
 
-class Return : public Transaction {
-private:
-  char mediaType;
-  string attribute1;
-  string attribute2;
-
+class Return {
 public:
-  Return();
-  Return(char, int, char, char, const string &, const string &);
-  virtual void execute(MovieTree &, HashTable &) override;
-  virtual ~Return();
+  static void execute(const Transaction &);
+  static bool apply(const Transaction &, Customer::HistoryEntry &);
+  static void record(const Transaction &, bool, const Customer::HistoryEntry &);
+  static bool report(const Transaction &, bool);
+  static Customer::HistoryEntry describe(const Transaction &);
 };
-#endif // RETURNH 
\ No newline at end of file
+#endif // RETURN_H
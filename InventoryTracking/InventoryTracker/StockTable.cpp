@@ -0,0 +1,157 @@
+/**
+ * StockTable - the stock counts of one genre's movies, kept apart from the
+ * movies themselves.
+ *
+ * A Movie holds a vtable pointer, its title and director (and, for classics,
+ * the major actor), all of which only matter when it is displayed or looked
+ * up. Borrows and returns only change the stock count, so a movie's count
+ * lives in a dense array here instead, indexed by a stock ID the movie is
+ * given when it is added. Each entry also holds the movie's row in the
+ * inventory cache watching the table, so a stock update touches one small
+ * entry and never the Movie. The movies are kept in a separate array for
+ * the few callers that need to go from an ID back to its movie.
+ *
+ * Movies are added while the Store is loaded. Entries may be updated from
+ * several threads at once, as long as each entry is only updated by one
+ * thread at a time.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "StockTable.h"
+#include "InventoryCache.h"
+#include "Movie.h"
+using namespace std;
+
+/**
+ * Class constructor
+ */
+StockTable::StockTable() : watcher(nullptr) {
+}
+
+/**
+ * Adds a movie to the table with its stock count as loaded. From then on 
+ * the movie reads its stock through the table.
+ *
+ * @param movie The movie to add; it must not be in a table already.
+ * @param stock The number of copies in stock.
+ * @return The movie's stock ID.
+ */
+unsigned StockTable::add(Movie *movie, int stock) {
+  unsigned id = entries.size();
+  entries.push_back(Entry{stock, 0});
+  movies.push_back(movie);
+  movie->attachStock(this, id);
+  return id;
+}
+
+/**
+ * Returns a movie's stock count.
+ *
+ * @param id The movie's stock ID.
+ * @return The number of copies in stock.
+ */
+int StockTable::get(unsigned id) const {
+  return entries[id].stock;
+}
+
+/**
+ * Takes one copy of a movie out of stock, unless it is out of stock.
+ *
+ * @param id The movie's stock ID.
+ * @return true if the movie was borrowed; false if it is out of stock.
+ */
+bool StockTable::borrow(unsigned id) {
+  if(Movie::isOutOfStock(entries[id].stock)) {
+    return false;
+  }
+
+  entries[id].stock--;
+  changed(id);
+  return true;
+}
+
+/**
+ * Puts one copy of a movie back in stock.
+ *
+ * @param id The movie's stock ID.
+ */
+void StockTable::giveBack(unsigned id) {
+  entries[id].stock++;
+  changed(id);
+}
+
+/**
+ * Changes a movie's stock count by a net amount in a single update.
+ *
+ * @param id The movie's stock ID.
+ * @param delta The net change in the number of copies in stock.
+ */
+void StockTable::adjust(unsigned id, int delta) {
+  entries[id].stock += delta;
+  changed(id);
+}
+
+/**
+ * Registers the inventory cache showing a movie, so the movie's row can
+ * be marked stale whenever its stock changes. A table is watched by one
+ * cache at a time.
+ *
+ * @param id The movie's stock ID.
+ * @param cache The cache to tell, or nullptr to stop watching the table.
+ * @param row The movie's row in the cache.
+ */
+void StockTable::watch(unsigned id, InventoryCache *cache, size_t row) {
+  // Rows are registered from several threads at once while a report is
+  // rendered, all for the same cache.
+  watcher.store(cache, memory_order_relaxed);
+  entries[id].row = row;
+}
+
+/**
+ * Returns the movie a stock ID belongs to.
+ *
+ * @param id The stock ID.
+ * @return The movie.
+ */
+Movie *StockTable::getMovie(unsigned id) const {
+  return movies[id];
+}
+
+/**
+ * Returns the number of movies in the table.
+ *
+ * @return The number of stock IDs given out.
+ */
+unsigned StockTable::size() const {
+  return entries.size();
+}
+
+/**
+ * Adds the memory of the stock entries and the movie index to a breakdown.
+ *
+ * @param stats The breakdown to add to.
+ */
+void StockTable::accountMemory(MemoryStats &stats) const {
+  stats.add(MemoryStats::StockEntries, entries.capacity() * sizeof(Entry)
+    + movies.capacity() * sizeof(Movie*), entries.size());
+}
+
+/**
+ * Tells the watching inventory cache, if any, that a movie's stock changed.
+ *
+ * @param id The movie's stock ID.
+ */
+void StockTable::changed(unsigned id) {
+  InventoryCache *cache = watcher.load(memory_order_relaxed);
+
+  if(cache != nullptr) {
+    cache->invalidate(entries[id].row);
+  }
+}
+
+/**
+ * Class Destructor
+ */
+StockTable::~StockTable() {}
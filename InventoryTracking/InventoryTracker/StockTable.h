@@ -0,0 +1,59 @@
+#ifndef STOCKTABLE_H
+#define STOCKTABLE_H
+
+/**
+ * StockTable - the stock counts of one genre's movies, kept apart from the
+ * movies themselves.
+ *
+ * A Movie holds a vtable pointer, its title and director (and, for classics,
+ * the major actor), all of which only matter when it is displayed or looked
+ * up. Borrows and returns only change the stock count, so a movie's count
+ * lives in a dense array here instead, indexed by a stock ID the movie is
+ * given when it is added. Each entry also holds the movie's row in the
+ * inventory cache watching the table, so a stock update touches one small
+ * entry and never the Movie. The movies are kept in a separate array for
+ * the few callers that need to go from an ID back to its movie.
+ *
+ * Movies are added while the Store is loaded. Entries may be updated from
+ * several threads at once, as long as each entry is only updated by one
+ * thread at a time.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "MemoryStats.h"
+#include <atomic>
+#include <vector>
+using namespace std;
+
+class InventoryCache;
+class Movie;
+
+class StockTable {
+public:
+  StockTable();
+  unsigned add(Movie *, int);
+  int get(unsigned) const;
+  bool borrow(unsigned);
+  void giveBack(unsigned);
+  void adjust(unsigned, int);
+  void watch(unsigned, InventoryCache *, size_t);
+  Movie *getMovie(unsigned) const;
+  unsigned size() const;
+  void accountMemory(MemoryStats &) const;
+  ~StockTable();
+
+private:
+  struct Entry {
+    int stock;
+    unsigned row;         // the movie's row in the watching inventory cache
+  };
+
+  vector<Entry> entries;
+  vector<Movie*> movies;  // the movie each entry belongs to
+  atomic<InventoryCache*> watcher;
+
+  void changed(unsigned);
+};
+#endif // STOCKTABLE_H
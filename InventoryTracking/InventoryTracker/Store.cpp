@@ -15,21 +15,37 @@
  * August 14, 2024
  */
 #include "Store.h"
+#include <chrono>
 #include <limits>
 using namespace std;
 
 /**
  * Class constructor
+ *
+ * @param useArena Whether loaded movies, customers and their tree nodes and 
+ *                 list nodes are created in the Store's arenas, which free 
+ *                 them all at once when the Store is destroyed, rather 
+ *                 than one by one on the heap. Movies and customers are 
+ *                 loaded concurrently, so each has an arena of its own.
  */
-Store::Store() {}
+Store::Store(bool useArena)
+  : usesArena(useArena), 
+    classicTree(useArena ? &movieArena : nullptr),
+    comedyTree(useArena ? &movieArena : nullptr),
+    dramaTree(useArena ? &movieArena : nullptr),
+    customers(101, useArena ? &customerArena : nullptr) {
+}
 
 /**
  * Loads and processes data from specified text files.
  * 
  * This method reads data from three files: one containing movie information, 
  * one containing customer information, and one containing transaction details. 
- * It sequentially reads and processes the data using the corresponding 
- * file-specific methods (`readMovies`, `readCustomers`, `readTransactions`).
+ * Each file may be plain text or gzip- or zstd-compressed; compressed files 
+ * are decompressed while they are parsed, without a copy on disk. 
+ * It reads and processes the data using the corresponding file-specific 
+ * methods (`readMovies`, `readCustomers`, `readTransactions`); movies and 
+ * customers are read concurrently, and transactions once both are loaded.
  * 
  * @param movieFile The path to the file containing movie data.
  * @param customerFile The path to the file containing customer data.
@@ -39,8 +55,58 @@ Store::Store() {}
  */
 bool Store::loadData(const string &movieFile, const string &customerFile,
   const string &transactionFile) {
-  return readMovies(movieFile) && readCustomers(customerFile)
-    && readTransactions(transactionFile);
+  Trace::Span span("Store::loadData");
+
+  if(!loadCatalog(movieFile, customerFile)) {
+    return false;
+  }
+
+  auto start = chrono::steady_clock::now();
+  bool transactionsRead = readTransactions(transactionFile);
+  loadStats.transactionMilliseconds 
+    = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+  return transactionsRead;
+}
+
+/**
+ * Loads the movie and customer data without reading any transactions.
+ * 
+ * This is the first part of `loadData`, and is used on its own when 
+ * transactions arrive later, for example through `followTransactions`.
+ * 
+ * @param movieFile The path to the file containing movie data.
+ * @param customerFile The path to the file containing customer data.
+ * @return Returns true if both files are successfully read and processed; 
+ *         returns false if either file fails to be read or processed.
+ */
+bool Store::loadCatalog(const string &movieFile, const string &customerFile) {
+  Trace::Span span("Store::loadCatalog");
+
+  // The customers are loaded on the thread pool while the movies load here.
+  // Their messages are held back and only shown if the movies loaded, as
+  // they would be had the files been read one after the other.
+  ostringstream customerMessages;
+  bool customersRead = false;
+  ThreadPool::TaskGroup group(runtime);
+
+  group.run([this, &customerFile, &customerMessages, &customersRead] {
+    auto start = chrono::steady_clock::now();
+    customersRead = readCustomers(customerFile, customerMessages);
+    loadStats.customerMilliseconds 
+      = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+  });
+
+  auto start = chrono::steady_clock::now();
+  bool moviesRead = readMovies(movieFile);
+  loadStats.movieMilliseconds 
+    = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+  group.wait();
+
+  if(moviesRead) {
+    cout << customerMessages.str();
+  }
+
+  return moviesRead && customersRead;
 }
 
 /**
@@ -48,40 +114,77 @@ bool Store::loadData(const string &movieFile, const string &customerFile,
  * The parsed Movie objects are then inserted into their respective genre-specific
  * binary search trees (Classic, Drama, Comedy). If a Movie cannot be parsed or 
  * has an unrecognized genre, it is discarded. The method returns true if the 
- * file was successfully processed, otherwise false if the file could not be opened.
+ * file was successfully processed, otherwise false if the file could not be opened
+ * or decompressed. Lines are parsed and inserted in blocks, each phase under 
+ * its own span, so a trace shows which of the two a slow load spends its 
+ * time in.
  *
  * @param movieFile The name of the file containing the movie data.
  * @return True if the file was successfully read and processed, false otherwise.
  */
 bool Store::readMovies(const string &movieFile) {
-  ifstream input(movieFile);
-  if(!input.is_open()) {
+  Trace::Span span("Store::readMovies");
+  PerfCounters::Phase phase("load movies");
+
+  LineReader input(movieFile);
+  if(!input.open()) {
     cout << "Error opening " << movieFile << "." << endl;
     return false;
   }
   
   string movieData;
+  vector<pair<Movie *, int>> parsed;
+  bool more = true;
 
-  while(getline(input, movieData)) {
-    parseMovieData(movieData);
+  while(more) {
+    {
+      Trace::Span parseSpan("Store::readMovies parse");
+      parsed.clear();
+
+      for(size_t line = 0; line < linesPerLoadBlock && (more = input.getline(movieData)); line++) {
+        int stock = 0;
+        Movie *newMovie = parseMovieData(movieData, stock);
+        if(newMovie != nullptr) {
+          parsed.emplace_back(newMovie, stock);
+        }
+      }
+    }
+
+    Trace::Span insertSpan("Store::readMovies insert");
+
+    for(const pair<Movie *, int> &movie : parsed) {
+      addMovie(movie.first, movie.second);
+    }
+  }
+
+  // The cached reports no longer cover every movie.
+  classicInventory.reset();
+  comedyInventory.reset();
+  dramaInventory.reset();
+
+  if(!input.close()) {
+    cout << "Error reading " << movieFile << ": " << input.getErrorMessage() << "." << endl;
+    return false;
   }
 
-  input.close();
   return true;
 }
 
 /**
  * Parses a line of movie data and creates a Movie object based on the genre.
+ * The movie is not yet in the catalog; `addMovie` inserts it.
  *
  * @param movieData The string containing the movie data to parse.
+ * @param stock Set to the number of copies the line gives.
+ * @return The new movie, or nullptr if the line could not be parsed.
  */
-void Store::parseMovieData(const string &movieData) {
+Movie* Store::parseMovieData(const string &movieData, int &stock) {
   istringstream input(movieData);
   char type = ' ';
   input >> type;
   input.ignore(2); 
 
-  int stock = 0;
+  stock = 0;
   input >> stock;
   input.ignore(2); 
 
@@ -90,13 +193,13 @@ void Store::parseMovieData(const string &movieData) {
   int month = 0, year = 0;
 
   if(!getline(input, director, ',')) {
-    return;
+    return nullptr;
   }
     
   director.erase(0, director.find_first_not_of(" \t")); 
 
   if(!std::getline(input, title, ',')) {
-    return;
+    return nullptr;
   }
     
   title.erase(0, title.find_first_not_of(" \t")); 
@@ -106,55 +209,80 @@ void Store::parseMovieData(const string &movieData) {
     getline(input, actorAndReleaseDate);
     actorAndReleaseDate.erase(0, actorAndReleaseDate.find_first_not_of(" \t")); 
 
-    if(!parseClassicMovies(stock, director, title, actorAndReleaseDate)) {
-      return;
-    }
+    return parseClassicMovies(director, title, actorAndReleaseDate);
 
   } else if (type == 'D' || type == 'F') {
       if(!(input >> year)) {
-        return;
+        return nullptr;
       }
 
-      Movie *newMovie = MovieFactory::createMovie(type, stock, director, title, "", 0, year);
+      return MovieFactory::createMovie(type, director, title, "", 0, year,
+        movieNames, usesArena ? &movieArena : nullptr);
 
-      switch(type) {
-        case 'D':
-          dramaTree.insert(newMovie);
-          break;
+  } else {
+      Log::write(Log::UnknownGenre, type);
+      return nullptr;
+  }
+}
 
-        case 'F':
-          comedyTree.insert(newMovie);
-          break;
+/**
+ * Inserts a parsed movie into its genre's tree and stock table.
+ *
+ * @param newMovie The movie, as returned by `parseMovieData`.
+ * @param stock The number of copies in stock.
+ */
+void Store::addMovie(Movie *newMovie, int stock) {
+  bool inserted = false;
 
-        default:
-          break;
+  switch(newMovie->getGenre()) {
+    case 'C':
+      inserted = classicTree.insert(newMovie);
+      if(inserted) {
+        classicStock.add(newMovie, stock);
       }
+      break;
 
-  } else {
-      cout << "Error: unknown genre " << type << "." << endl;
-      return;
+    case 'D':
+      inserted = dramaTree.insert(newMovie);
+      if(inserted) {
+        dramaStock.add(newMovie, stock);
+      }
+      break;
+
+    case 'F':
+      inserted = comedyTree.insert(newMovie);
+      if(inserted) {
+        comedyStock.add(newMovie, stock);
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  // Duplicates are discarded; in the arena they are freed with the rest.
+  if(!inserted && !usesArena) {
+    delete newMovie;
   }
 }
 
 /**
  * Parses details specific to Classic movies such as the actor's name and release date.
  *
- * @param details The string containing the actor's name and release date.
  * @param director The director of the movie.
  * @param title The title of the movie.
- * @param stock The stock of the movie.
- * @return True if details were successfully parsed, false otherwise.
+ * @param details The string containing the actor's name and release date.
+ * @return The new Classic movie.
  */
-bool Store::parseClassicMovies(int stock, const string &director, const string &title, const string &details) {
+Movie* Store::parseClassicMovies(const string &director, const string &title, const string &details) {
   istringstream input(details);
   string actor = "",
   firstName = "", lastName = "";  
   int month = 0, year = 0;
   input >> firstName >> lastName >> month >> year;
   actor = firstName + " " + lastName;
-  Movie *newMovie = MovieFactory::createMovie('C', stock, director, title, actor, month, year);
-  classicTree.insert(newMovie);
-  return true;
+  return MovieFactory::createMovie('C', director, title, actor, month, year,
+    movieNames, usesArena ? &movieArena : nullptr);
 }
 
 
@@ -166,27 +294,50 @@ bool Store::parseClassicMovies(int stock, const string &director, const string &
  * as needed, such as being added to a data structure for later use.
  *
  * @param customerFile The path to the file containing customer data.
+ * @param messages The stream that error messages are written to.
  * @return True if the file was successfully opened and processed; 
  *         false if there was an error opening the file.
  */
-bool Store::readCustomers(const string &customerFile) {
-  ifstream input(customerFile);
+bool Store::readCustomers(const string &customerFile, ostream &messages) {
+  Trace::Span span("Store::readCustomers");
+  PerfCounters::Phase phase("load customers");
 
-  if(!(input.is_open())) {
-    cout << "Error opening file " << customerFile << endl;
+  LineReader input(customerFile);
+
+  if(!(input.open())) {
+    messages << "Error opening file " << customerFile << endl;
     return false;
   }
 
   string customerData;
+  vector<Customer *> parsed;
+  bool more = true;
+
+  while(more) {
+    {
+      Trace::Span parseSpan("Store::readCustomers parse");
+      parsed.clear();
+
+      for(size_t line = 0; line < linesPerLoadBlock && (more = input.getline(customerData)); line++) {
+        Customer *newCustomer = parseCustomerData(customerData);
+        if(newCustomer != nullptr) {
+          parsed.push_back(newCustomer);
+        }
+      }
+    }
+
+    Trace::Span insertSpan("Store::readCustomers insert");
 
-  while(getline(input, customerData)) {
-    Customer *newCustomer = parseCustomerData(customerData);
-    if(newCustomer != nullptr) {
+    for(Customer *newCustomer : parsed) {
       customers.insert(newCustomer);
-    } 
+    }
+  }
+
+  if(!input.close()) {
+    messages << "Error reading " << customerFile << ": " << input.getErrorMessage() << "." << endl;
+    return false;
   }
 
-  input.close();
   return true;
 }
 
@@ -206,7 +357,8 @@ Customer* Store::parseCustomerData(const string &customerData) {
   string firstName = "", lastName = "";
 
   if(input >> customerID && input >> firstName >> lastName) {
-    return new Customer(customerID, firstName, lastName);
+    return usesArena ? customerArena.create<Customer>(customerID, firstName, lastName)
+      : new Customer(customerID, firstName, lastName);
   }
   
   return nullptr;
@@ -215,54 +367,81 @@ Customer* Store::parseCustomerData(const string &customerData) {
 /**
  * Reads transaction data from a file and processes each transaction.
  * Opens the specified file and reads it line by line. Each line represents
- * a transaction in a predefined format. For each line, a Transaction object
- * is created by parsing the line. Valid transactions are added to the 
- * `transactions` vector. If a transaction cannot be parsed, an error message
- * is printed.
+ * a transaction in a predefined format. For each line, a Transaction value
+ * is created by parsing the line. Valid transactions are prepared and then 
+ * appended by value to the contiguous `transactions` buffer. If a transaction cannot be parsed, an error message
+ * is printed. Lines are parsed and resolved in blocks, each phase under its
+ * own span.
  *
  * @param transactionFile The name of the file containing transaction data.
  * @return true if all transactions were successfully read and processed;
  *         false if there was an error opening the file or reading its contents.
  */
 bool Store::readTransactions(const string &transactionFile) {
-  ifstream input(transactionFile);
+  Trace::Span span("Store::readTransactions");
+  PerfCounters::Phase phase("load commands");
+
+  LineReader input(transactionFile);
 
-  if(!(input.is_open())) {
+  if(!(input.open())) {
     cout << "Error opening " << transactionFile << "." << endl;
     return false;
   }
 
   string transactionData;
+  Transaction newTransaction;
+  vector<Transaction> parsed;
+  bool more = true;
+
+  while(more) {
+    {
+      Trace::Span parseSpan("Store::readTransactions parse");
+      parsed.clear();
+
+      for(size_t line = 0; line < linesPerLoadBlock && (more = input.getline(transactionData)); line++) {
+        if(parseTransactionData(transactionData, newTransaction)) {
+          parsed.push_back(newTransaction);
+        } 
+      }
+    }
 
-  while(getline(input, transactionData)) {
-    Transaction* newTransaction = parseTransactionData(transactionData);
-    if(newTransaction != nullptr) {
-      transactions.push_back(newTransaction);
-    } 
+    // Resolving looks the movie and customer up in the trees and hash table.
+    Trace::Span resolveSpan("Store::readTransactions resolve");
+
+    for(Transaction &transaction : parsed) {
+      prepareTransaction(transaction);
+      transactions.push_back(transaction);
+    }
+  }
+
+  if(!input.close()) {
+    cout << "Error reading " << transactionFile << ": " << input.getErrorMessage() << "." << endl;
+    return false;
   }
 
-  input.close();
   return true;
 }
 
 /**
- * Parses a line of transaction data and creates the corresponding Transaction object.
+ * Parses a line of transaction data and creates the corresponding Transaction.
  * This function takes a single line of transaction data, which includes various
  * attributes such as transaction type, customer ID, media type, genre, and additional
  * attributes. Based on the transaction type (denoted by the first character), it
- * delegates the creation of the Transaction object to the TransactionFactory.
+ * delegates the creation of the Transaction to the TransactionFactory.
  * 
  * The transaction types are as follows:
  * - 'B': Borrow transaction
- * - 'H': Return transaction
+ * - 'H': History transaction
  * - 'I': Inventory transaction
- * - 'R': Reserve transaction
+ * - 'R': Return transaction
+ * - 'S': Stats transaction, which displays the Store's memory usage
  * 
  * @param transactionData A string containing the transaction data to be parsed.
- * @return A pointer to the created Transaction object if the transaction type is valid;
- *         nullptr if the transaction type is unknown or if there is an error parsing the data.
+ * @param transaction Receives the parsed Transaction on success.
+ * @return true if the transaction type is valid and the data was parsed;
+ *         false if the transaction type is unknown or if there is an error parsing the data.
  */
-Transaction* Store::parseTransactionData(const string &transactionData) {
+bool Store::parseTransactionData(const string &transactionData, Transaction &transaction) {
   istringstream input(transactionData);
   char transType;
   int customerID = 0;
@@ -270,23 +449,24 @@ Transaction* Store::parseTransactionData(const string &transactionData) {
 
   switch (transType) {
     case 'I':
-      return TransactionFactory::createTransaction('I', 0, ' ', ' ', "", "");
+    case 'S':
+      return TransactionFactory::createTransaction(transType, 0, ' ', ' ', -1, -1, transaction);
 
     case 'H':
       input >> customerID;
-      return TransactionFactory::createTransaction('H', customerID, ' ', ' ', "", "");
+      return TransactionFactory::createTransaction('H', customerID, ' ', ' ', -1, -1, transaction);
 
     case 'B':
       case 'R': {
         input >> customerID;
         char mediaType, genre;
         input >> mediaType >> genre;
-        return parseBorrowOrReturnTransaction(input, transType, customerID, mediaType, genre);
+        return parseBorrowOrReturnTransaction(input, transType, customerID, mediaType, genre, transaction);
     }
 
     default:
-      cerr << "Error: unknown transaction code " << transType << "." << std::endl;
-      return nullptr;
+      Log::write(Log::UnknownTransactionCode, transType);
+      return false;
   }
 }
 
@@ -301,24 +481,28 @@ Transaction* Store::parseTransactionData(const string &transactionData) {
  * - 'D': Dramas, which include director and movie title.
  * - 'F': Comedies, which include movie title and release year.
  * 
- * The parsed data is used to create a Transaction object through the TransactionFactory.
+ * The parsed attributes are interned into the Store's StringPool and the resulting 
+ * handles are used to create a Transaction through the TransactionFactory.
  * 
  * @param input The input stream containing the transaction data.
  * @param transType The type of transaction ('B' for Borrow, 'R' for Return).
  * @param customerID The ID of the customer involved in the transaction.
  * @param mediaType The type of media involved in the transaction.
  * @param genre The genre of the movie involved in the transaction.
- * @return A pointer to the created Transaction object if the genre is valid;
- *         nullptr if the genre is unknown.
+ * @param transaction Receives the parsed Transaction on success.
+ * @return true if the genre is valid and the Transaction was created;
+ *         false if the genre is unknown.
  */
-Transaction* Store::parseBorrowOrReturnTransaction(std::istringstream &input, char transType, int customerID, char mediaType, char genre) {
+bool Store::parseBorrowOrReturnTransaction(std::istringstream &input, char transType, int customerID,
+  char mediaType, char genre, Transaction &transaction) {
   switch (genre) {
     case 'C': {
       string month, year, firstName, lastName;
       input >> month >> year >> firstName >> lastName;
       string releaseDate = month + " " + year;
       string actor = firstName + " " + lastName;
-      return TransactionFactory::createTransaction(transType, customerID, mediaType, genre, releaseDate, actor);
+      return TransactionFactory::createTransaction(transType, customerID, mediaType, genre,
+        attributes.intern(releaseDate), attributes.intern(actor), transaction);
     }
 
     case 'D': {
@@ -326,7 +510,8 @@ Transaction* Store::parseBorrowOrReturnTransaction(std::istringstream &input, ch
       getline(input >> ws, director, ',');
       getline(input >> ws, title, ',');
       title = trim(title);
-      return TransactionFactory::createTransaction(transType, customerID, mediaType, genre, director, title);
+      return TransactionFactory::createTransaction(transType, customerID, mediaType, genre,
+        attributes.intern(director), attributes.intern(title), transaction);
     }
 
     case 'F': {
@@ -334,15 +519,121 @@ Transaction* Store::parseBorrowOrReturnTransaction(std::istringstream &input, ch
       getline(input >> ws, title, ',');
       getline(input >> ws, year, ',');
       year = trim(year);
-      return TransactionFactory::createTransaction(transType, customerID, mediaType, genre, title, year);
+      return TransactionFactory::createTransaction(transType, customerID, mediaType, genre,
+        attributes.intern(title), attributes.intern(year), transaction);
     }
 
     default:
-      cout << "Error: unknown genre code " << genre << "." << std::endl;
-      return nullptr;
+      Log::write(Log::UnknownGenreCode, genre);
+      return false;
   }
 }
 
+/**
+ * Prepares a parsed transaction for execution by resolving the customer and 
+ * movie it refers to. The lookups happen once here, at parse time, and 
+ * movies are remembered by their interned attributes, so that 
+ * executing (or re-executing) the transaction only updates the resolved 
+ * movie's stock and customer's history. Customers or movies that cannot be 
+ * found are left unresolved and reported as errors when the transaction runs.
+ *
+ * Movies and customers must already be loaded, and must not be replaced 
+ * afterwards, for the resolved handles to remain valid.
+ *
+ * @param transaction The parsed Transaction to prepare.
+ */
+void Store::prepareTransaction(Transaction &transaction) {
+  char transType = transaction.getTransType();
+
+  if(transType == 'B' || transType == 'R') {
+    char genre = transaction.getGenreOfMovie();
+    int attribute1 = transaction.getAttribute1();
+    int attribute2 = transaction.getAttribute2();
+    const int handleBits = 28;
+    Movie* movie = nullptr;
+
+    // Equal attributes share interned handles, so each distinct movie key
+    // only has to be searched for in its tree once.
+    if(attribute1 < (1 << handleBits) && attribute2 < (1 << handleBits)) {
+      long long key = (static_cast<long long>(genre) << (2 * handleBits))
+        | (static_cast<long long>(attribute1) << handleBits) | attribute2;
+      auto found = resolvedMovies.find(key);
+
+      if(found != resolvedMovies.end()) {
+        movie = found->second;
+
+      } else {
+          movie = resolveMovie(genre, attributes.get(attribute1), attributes.get(attribute2));
+          resolvedMovies.emplace(key, movie);
+      }
+
+    } else {
+        movie = resolveMovie(genre, attributes.get(attribute1), attributes.get(attribute2));
+    }
+
+    transaction.resolve(customers.get(transaction.getCustomerID()), movie);
+
+  } else if(transType == 'H') {
+      transaction.resolve(customers.get(transaction.getCustomerID()), nullptr);
+  }
+}
+
+/**
+ * Looks up a movie in the tree for its genre using the attributes given in a 
+ * borrow or return command. The attributes identify the movie differently 
+ * for each genre:
+ * 
+ * - 'C': release month and year, then the major actor.
+ * - 'D': director, then title.
+ * - 'F': title, then release year.
+ * 
+ * The names are looked up in the pool the movies' names are interned in 
+ * without adding them, so a name no movie has is known not to match 
+ * before any tree is searched.
+ * 
+ * @param genre The genre code of the movie.
+ * @param attribute1 The first attribute of the command.
+ * @param attribute2 The second attribute of the command.
+ * @return A pointer to the matching Movie, or nullptr if there is none.
+ */
+Movie* Store::resolveMovie(char genre, const string &attribute1, const string &attribute2) {
+  Movie* found = nullptr;
+  stats.movieLookups++;
+
+  if(genre == 'C') {
+    int month = 0, year = 0;
+    istringstream releaseData(attribute1);
+    releaseData >> month >> year;
+    int actor = movieNames.find(attribute2);
+
+    if(actor >= 0) {
+      classicTree.retrieve(Classic(genre, -1, -1, 
+        actor, month, year, &movieNames), found);
+    }
+
+  } else if(genre == 'D') {
+      int director = movieNames.find(attribute1), title = movieNames.find(attribute2);
+
+      if(director >= 0 && title >= 0) {
+        dramaTree.retrieve(Drama(genre, director, 
+          title, 0, &movieNames), found);
+      }
+
+  } else if(genre == 'F') {
+      int year = 0;
+      istringstream releaseYear(attribute2);
+      releaseYear >> year;
+      int title = movieNames.find(attribute1);
+
+      if(title >= 0) {
+        comedyTree.retrieve(Comedy(genre, -1, 
+          title, year, &movieNames), found);
+      }
+  }
+
+  return found;
+}
+
 /**
  * Trims leading and trailing whitespace (spaces and tabs) from the input string.
  *
@@ -362,45 +653,708 @@ string Store::trim(const std::string &str) {
 
 /**
  * Iterate through all stored transactions and process each one.
- * Each transaction is executed against the movie trees for classic, comedy, and drama genres,
- * and the customer data is provided to handle the transaction's effects on both movies and customers.
+ * Transactions are stored by value in one contiguous buffer, so this loop
+ * walks them sequentially and hands each to `executeTransaction`.
  */
 void Store::processTransactions() {
-  for(Transaction* transaction : transactions) {
-    if(transaction == nullptr) {
-      cout << "Error: encountered a null transaction." << endl;
+  Trace::Span span("Store::processTransactions");
+  PerfCounters::Phase phase("execute");
+
+  for(const Transaction &transaction : transactions) {
+    executeTransaction(transaction);
+  }
+}
+
+/**
+ * Processes all stored transactions like `processTransactions`, timing 
+ * each one and recording its latency under its transaction type. Looking 
+ * up the type's histogram is left out of the timing.
+ *
+ * @param latencies The latency histograms to add to, by transaction type.
+ */
+void Store::processTransactions(map<char, LatencyHistogram> &latencies) {
+  Trace::Span span("Store::processTransactions");
+  PerfCounters::Phase phase("execute");
+
+  for(const Transaction &transaction : transactions) {
+    auto start = chrono::steady_clock::now();
+    executeTransaction(transaction);
+    auto finish = chrono::steady_clock::now();
+    latencies[transaction.getTransType()].record(
+      chrono::duration_cast<chrono::nanoseconds>(finish - start).count());
+  }
+}
+
+/**
+ * Processes all stored transactions like `processTransactions`, but applies
+ * borrows and returns as one task per genre on the Store's thread pool.
+ * 
+ * The classic, comedy and drama trees are independent, so each genre's 
+ * borrow and return transactions are collected into a batch that a single 
+ * task applies in order; tasks for different genres never touch the same 
+ * movie. Tasks only update stock and build history entries; the results 
+ * are then recorded on this thread in the original transaction order, so 
+ * error messages and every customer's history come out exactly as with 
+ * sequential processing. History and inventory transactions read state the 
+ * tasks modify, so they act as barriers: the batches are joined and their 
+ * results recorded before such a transaction is executed.
+ */
+void Store::processTransactionsByGenre() {
+  Trace::Span span("Store::processTransactionsByGenre");
+  PerfCounters::Phase phase("execute");
+
+  vector<char> results(transactions.size(), 0);
+  vector<Customer::HistoryEntry> entries(transactions.size());
+  vector<size_t> batches[3];
+  size_t segmentStart = 0;
+
+  for(size_t i = 0; i <= transactions.size(); i++) {
+    if(i < transactions.size()) {
+      char transType = transactions[i].getTransType();
+      char genre = transactions[i].getGenreOfMovie();
+      vector<size_t> *batch = genre == 'C' ? &batches[0] 
+        : genre == 'F' ? &batches[1] : genre == 'D' ? &batches[2] : nullptr;
+
+      if((transType == 'B' || transType == 'R') && batch != nullptr) {
+        batch->push_back(i);
+        continue;
+      }
+    }
+
+    {
+      ThreadPool::TaskGroup group(runtime);
+
+      for(vector<size_t> &batch : batches) {
+        if(!batch.empty()) {
+          group.run([this, &batch, &results, &entries] {
+            applyGenreBatch(batch, results, entries);
+          });
+        }
+      }
+
+      group.wait();
+    }
+
+    for(vector<size_t> &batch : batches) {
+      batch.clear();
+    }
+
+    for(size_t j = segmentStart; j < i; j++) {
+      recordTransaction(transactions[j], results[j], entries[j]);
+    }
+
+    if(i < transactions.size()) {
+      executeTransaction(transactions[i]);
+    }
+
+    segmentStart = i + 1;
+  }
+}
+
+/**
+ * Applies one genre's batch of borrow and return transactions in order, 
+ * updating stock and building history entries without recording them.
+ *
+ * @param batch The indices of the transactions to apply.
+ * @param results Receives the result of `apply` for each applied index.
+ * @param entries Receives the history entry for each applied index.
+ */
+void Store::applyGenreBatch(const vector<size_t> &batch, vector<char> &results,
+  vector<Customer::HistoryEntry> &entries) {
+  Trace::Span span("Store::applyGenreBatch");
+
+  for(size_t index : batch) {
+    const Transaction &transaction = transactions[index];
+
+    if(transaction.getTransType() == 'B') {
+      results[index] = Borrow::apply(transaction, entries[index]);
+
+    } else {
+        results[index] = Return::apply(transaction, entries[index]);
+    }
+  }
+}
+
+/**
+ * Processes all stored transactions like `processTransactions`, but runs 
+ * non-conflicting borrows and returns in parallel on the Store's thread pool.
+ * 
+ * The transactions are split into batches of borrows and returns separated 
+ * by history and inventory transactions, which run on this thread between 
+ * batches. Each batch is scheduled by `executeInWaves`. Error messages are 
+ * logged afterwards in the original transaction order, so the output, 
+ * final stock and every customer's history match sequential processing.
+ */
+void Store::processTransactionsInWaves() {
+  Trace::Span span("Store::processTransactionsInWaves");
+  PerfCounters::Phase phase("execute");
+
+  vector<char> results(transactions.size(), 0);
+  size_t batchStart = 0;
+
+  for(size_t i = 0; i <= transactions.size(); i++) {
+    if(i < transactions.size()) {
+      char transType = transactions[i].getTransType();
+
+      if(transType == 'B' || transType == 'R') {
+        continue;
+      }
+    }
+
+    executeInWaves(batchStart, i, results);
+
+    for(size_t j = batchStart; j < i; j++) {
+      if(transactions[j].getTransType() == 'B') {
+        Borrow::report(transactions[j], results[j]);
+
+      } else {
+          Return::report(transactions[j], results[j]);
+      }
+    }
+
+    if(i < transactions.size()) {
+      executeTransaction(transactions[i]);
+    }
+
+    batchStart = i + 1;
+  }
+}
+
+/**
+ * Executes a batch of borrow and return transactions in parallel waves.
+ * 
+ * Two transactions conflict when they share a customer (whose history they 
+ * both append to) or a movie (whose stock they both update). Walking the 
+ * batch in order, each transaction is placed in the wave after the latest 
+ * wave holding a transaction it conflicts with. Transactions in the same 
+ * wave therefore touch disjoint customers and movies and can run 
+ * concurrently, while conflicting transactions still run in their original 
+ * order. Waves run one after another, each split into chunks across the 
+ * Store's thread pool. Transactions with an unresolved customer or movie 
+ * have no effects and are not scheduled.
+ *
+ * @param start The index of the first transaction in the batch.
+ * @param end One past the index of the last transaction in the batch.
+ * @param results Receives the result of applying each transaction.
+ */
+void Store::executeInWaves(size_t start, size_t end, vector<char> &results) {
+  Trace::Span span("Store::executeInWaves");
+
+  unordered_map<const Customer*, size_t> customerWaves;
+  unordered_map<const Movie*, size_t> movieWaves;
+  vector<vector<size_t>> waves;
+
+  for(size_t i = start; i < end; i++) {
+    if(!transactions[i].isResolved()) {
       continue;
     }
 
-    char transType = transaction->getTransType();
-    char genre = transaction->getGenreOfMovie();
+    // Each map holds one more than the latest wave touching its key.
+    size_t &customerNext = customerWaves[transactions[i].getCustomer()];
+    size_t &movieNext = movieWaves[transactions[i].getMovie()];
+    size_t wave = max(customerNext, movieNext);
 
-    if(transType == 'B' || transType == 'R') {
-      if(genre == 'C') {
-        transaction->execute(classicTree, customers);
+    if(wave == waves.size()) {
+      waves.emplace_back();
+    }
 
-      } else if(genre == 'D') {
-          transaction->execute(dramaTree, customers);
+    waves[wave].push_back(i);
+    customerNext = movieNext = wave + 1;
+    stats.stockUpdates++;
+  }
+
+  const size_t minimumChunk = 256;
+
+  for(const vector<size_t> &wave : waves) {
+    size_t chunk = max(minimumChunk, wave.size() / runtime.size() + 1);
 
-      } else if(genre == 'F') {
-          transaction->execute(comedyTree, customers);
+    runtime.parallelFor(0, wave.size(), chunk, [this, &wave, &results](size_t first, size_t last) {
+      Trace::Span span("Store::executeInWaves chunk");
+      Customer::HistoryEntry entry;
+
+      for(size_t k = first; k < last; k++) {
+        const Transaction &transaction = transactions[wave[k]];
+        results[wave[k]] = transaction.getTransType() == 'B'
+          ? Borrow::apply(transaction, entry) : Return::apply(transaction, entry);
+        transaction.getCustomer()->addTransaction(entry);
+      }
+    });
+  }
+}
+
+/**
+ * Processes all stored transactions like `processTransactions`, but 
+ * coalesces the stock updates of borrows and returns of the same movie.
+ * 
+ * The transactions are split into batches of borrows and returns separated 
+ * by history and inventory transactions, which run normally between 
+ * batches. Each batch is executed by `executeCoalesced`, and then every 
+ * transaction in it is recorded in the original order, so the output, 
+ * final stock and every customer's history match sequential processing.
+ */
+void Store::processTransactionsCoalesced() {
+  Trace::Span span("Store::processTransactionsCoalesced");
+  PerfCounters::Phase phase("execute");
+
+  vector<char> results(transactions.size(), 0);
+  vector<StockScratch> scratch;
+  size_t batchStart = 0;
+
+  for(StockTable *table : {&classicStock, &comedyStock, &dramaStock}) {
+    scratch.push_back(StockScratch{table, vector<int>(table->size(), unloaded), {}});
+  }
+
+  for(size_t i = 0; i <= transactions.size(); i++) {
+    if(i < transactions.size()) {
+      char transType = transactions[i].getTransType();
+
+      if(transType == 'B' || transType == 'R') {
+        continue;
+      }
+    }
+
+    executeCoalesced(batchStart, i, results, scratch);
+    Customer::HistoryEntry entry;
+
+    for(size_t j = batchStart; j < i; j++) {
+      const Transaction &transaction = transactions[j];
+
+      if(transaction.getTransType() == 'B') {
+        entry = transaction.isResolved() ? Borrow::describe(transaction) : Customer::HistoryEntry();
+        Borrow::record(transaction, results[j], entry);
 
       } else {
-          cout << "Error: unknown Movie genre " << genre << "." << endl;
+          entry = transaction.isResolved() ? Return::describe(transaction) : Customer::HistoryEntry();
+          Return::record(transaction, results[j], entry);
       }
- 
-    } else if(transType == 'H') {
-        MovieTree temp;
-        transaction->execute(temp, customers);
+    }
+
+    if(i < transactions.size()) {
+      executeTransaction(transactions[i]);
+    }
+
+    batchStart = i + 1;
+  }
+}
+
+/**
+ * Applies the stock changes of a batch of borrow and return transactions 
+ * with one update per movie.
+ * 
+ * The batch's resolved transactions are replayed in their original order 
+ * against running counts in the scratch arrays, indexed by stock ID, so no
+ * grouping is needed. A movie's count is loaded from its stock table the 
+ * first time the batch touches it, and decides whether each borrow finds 
+ * the movie out of stock exactly as it would have one at a time. The net 
+ * change of each touched movie is then written back in a single update, 
+ * and its scratch count is cleared for the next batch.
+ *
+ * @param start The index of the first transaction in the batch.
+ * @param end One past the index of the last transaction in the batch.
+ * @param results Receives whether each transaction succeeded.
+ * @param scratch The running counts of each genre, all unloaded on entry
+ *                and on return.
+ */
+void Store::executeCoalesced(size_t start, size_t end, vector<char> &results, 
+  vector<StockScratch> &scratch) {
+  Trace::Span span("Store::executeCoalesced");
+
+  for(size_t i = start; i < end; i++) {
+    const Transaction &transaction = transactions[i];
+
+    if(!transaction.isResolved()) {
+      continue;
+    }
+
+    StockScratch *genre = &scratch[0];
 
-    } else if(transType == 'I') {
-        transaction->execute(classicTree, customers);
-        transaction->execute(comedyTree, customers);
-        transaction->execute(classicTree, customers);
+    while(genre->table != transaction.getStockTable()) {
+      genre++;
+    }
+
+    unsigned stockId = transaction.getStockId();
+    int &stock = genre->counts[stockId];
+
+    if(stock == unloaded) {
+      stock = genre->table->get(stockId);
+      genre->touched.push_back(stockId);
+    }
+
+    if(transaction.getTransType() == 'R') {
+      stock++;
+      results[i] = true;
+
+    } else if(Movie::isOutOfStock(stock)) {
+        results[i] = false;
 
     } else {
-        cout << "Error: unknown transaction type " << transType << " encountered." << endl;
+        stock--;
+        results[i] = true;
+    }
+  }
+
+  for(StockScratch &genre : scratch) {
+    for(unsigned stockId : genre.touched) {
+      genre.table->adjust(stockId, genre.counts[stockId] - genre.table->get(stockId));
+      genre.counts[stockId] = unloaded;
+      stats.stockUpdates++;
+    }
+
+    genre.touched.clear();
+  }
+}
+
+/**
+ * Returns counters describing the work done to prepare and execute the 
+ * transactions processed so far.
+ *
+ * @return The Store's execution statistics.
+ */
+Store::ExecutionStats Store::getExecutionStats() const {
+  return stats;
+}
+
+/**
+ * Returns how long each data file took to read and parse the last time 
+ * it was loaded. The customers are read alongside the movies, so their 
+ * times overlap.
+ *
+ * @return The Store's load statistics.
+ */
+Store::LoadStats Store::getLoadStats() const {
+  return loadStats;
+}
+
+/**
+ * Breaks down the memory the Store holds by subsystem: movies and their 
+ * strings, stock entries, tree nodes, cached inventory reports, customers, their 
+ * histories, stored transactions, interned command attributes and command
+ * latency histograms, with 
+ * the arenas' blocks alongside. Every structure is walked, so this takes 
+ * time in proportion to what is loaded.
+ *
+ * @return The Store's memory usage.
+ */
+MemoryStats Store::getMemoryStats() const {
+  MemoryStats memory;
+  classicTree.accountMemory(memory);
+  comedyTree.accountMemory(memory);
+  dramaTree.accountMemory(memory);
+  movieNames.accountMemory(memory, MemoryStats::MovieStrings);
+  classicStock.accountMemory(memory);
+  comedyStock.accountMemory(memory);
+  dramaStock.accountMemory(memory);
+  classicInventory.accountMemory(memory);
+  comedyInventory.accountMemory(memory);
+  dramaInventory.accountMemory(memory);
+  customers.accountMemory(memory);
+  memory.add(MemoryStats::Transactions, transactions.capacity() * sizeof(Transaction), 
+    transactions.size());
+  attributes.accountMemory(memory, MemoryStats::CommandAttributes);
+  commandStats.accountMemory(memory);
+  memory.add(MemoryStats::CommandAttributes, resolvedMovies.bucket_count() * sizeof(void*)
+    + resolvedMovies.size() * (sizeof(pair<const long long, Movie*>) + sizeof(void*)), 0);
+  memory.addArena(movieArena.bytesUsed() + customerArena.bytesUsed(), 
+    movieArena.bytesReserved() + customerArena.bytesReserved());
+  return memory;
+}
+
+/**
+ * Returns the Store's thread pool, which loading and the parallel 
+ * execution modes submit their work to.
+ *
+ * @return The Store's thread pool.
+ */
+ThreadPool &Store::getRuntime() {
+  return runtime;
+}
+
+/**
+ * Records the result of a borrow or return transaction that was applied 
+ * by a worker, logging any error messages and adding it to the 
+ * customer's record.
+ *
+ * @param transaction The borrow or return Transaction that was applied.
+ * @param succeeded The result of applying the transaction.
+ * @param entry The history entry built when the transaction was applied.
+ */
+void Store::recordTransaction(const Transaction &transaction, bool succeeded, 
+  const Customer::HistoryEntry &entry) {
+  stats.stockUpdates += transaction.isResolved();
+
+  if(transaction.getTransType() == 'B') {
+    Borrow::record(transaction, succeeded, entry);
+
+  } else {
+      Return::record(transaction, succeeded, entry);
+  }
+}
+
+/**
+ * Parses a single command line and executes it immediately, without adding
+ * it to the stored transactions. Used for commands that arrive while the 
+ * Store is running, from a followed file or a client connection.
+ *
+ * @param transactionData The command line to execute.
+ * @return true if the command was parsed and executed; false otherwise.
+ */
+bool Store::executeCommand(const string &transactionData) {
+  Transaction newTransaction;
+
+  if(!parseTransactionData(transactionData, newTransaction)) {
+    return false;
+  }
+
+  prepareTransaction(newTransaction);
+  executeTransaction(newTransaction);
+  return true;
+}
+
+/**
+ * Parses a single command line and executes it like `executeCommand`, 
+ * except that inventory and history reports are handed back instead of 
+ * printed. An inventory command returns the cached report of every genre,
+ * shared with the inventory caches rather than copied. A history report 
+ * is deferred: its state is recorded now, at its place in the command 
+ * order, and the returned report function renders it later, possibly on 
+ * another thread while further commands run. Borrows and returns execute
+ * immediately.
+ *
+ * @param transactionData The command line to execute.
+ * @param report Set to a function that writes the report to a stream, for 
+ *               history commands; emptied otherwise.
+ * @param reports Set to the rendered reports, in display order, for 
+ *                inventory commands; emptied otherwise. They do not 
+ *                change after being returned.
+ * @return true if the command was parsed; false otherwise.
+ */
+bool Store::executeCommand(const string &transactionData, function<void(ostream &)> &report,
+  vector<shared_ptr<const string>> &reports) {
+  Transaction newTransaction;
+  report = nullptr;
+  reports.clear();
+
+  if(!parseTransactionData(transactionData, newTransaction)) {
+    return false;
+  }
+
+  prepareTransaction(newTransaction);
+
+  if(newTransaction.getTransType() == 'I') {
+    CommandStats::Sample sample(commandStats, 'I', ' ');
+    reports = refreshInventory();
+
+  } else if(newTransaction.getTransType() == 'H') {
+      CommandStats::Sample sample(commandStats, 'H', ' ', true);
+      History::Snapshot history = History::snapshot(newTransaction);
+      report = [history = move(history)](ostream &out) { History::render(history, out); };
+
+  } else {
+      executeTransaction(newTransaction);
+  }
+
+  return true;
+}
+
+/**
+ * Follows a transaction file as it grows and executes each command as soon 
+ * as its line is complete.
+ * 
+ * Commands already in the file are executed first; after that only newly 
+ * appended bytes are read, so the file is never re-read. Followed commands 
+ * are parsed, prepared and executed immediately rather than being added to 
+ * the stored transactions. When following stops, the number of commands 
+ * executed and the delay between each command's line being seen in the 
+ * file and its execution finishing are reported.
+ * 
+ * @param transactionFile The name of the file to follow.
+ * @param idleTimeout Stop after this many milliseconds without new commands; 
+ *                    0 follows the file indefinitely.
+ * @return false if the file could not be opened; true otherwise.
+ */
+bool Store::followTransactions(const string &transactionFile, int idleTimeout) {
+  FileFollower follower(transactionFile);
+
+  if(!follower.open()) {
+    cout << "Error opening " << transactionFile << "." << endl;
+    return false;
+  }
+
+  const int waitInterval = 100;
+  vector<string> lines;
+  vector<chrono::steady_clock::time_point> arrivals;
+  long long commandCount = 0, appendedCount = 0;
+  double totalLatency = 0.0, maxLatency = 0.0;
+  auto lastActivity = chrono::steady_clock::now();
+
+  while(idleTimeout <= 0 || chrono::steady_clock::now() - lastActivity 
+    < chrono::milliseconds(idleTimeout)) {
+    lines.clear();
+    arrivals.clear();
+
+    if(!follower.waitForLines(lines, arrivals, waitInterval)) {
+      continue;
+    }
+
+    for(size_t i = 0; i < lines.size(); i++) {
+      commandCount += executeCommand(lines[i]);
+
+      // Commands that were already in the file were not freshly appended.
+      if(arrivals[i] != chrono::steady_clock::time_point()) {
+        appendedCount++;
+        double latency = chrono::duration<double, milli>(
+          chrono::steady_clock::now() - arrivals[i]).count();
+        totalLatency += latency;
+        maxLatency = max(maxLatency, latency);
+      }
+    }
+
+    lastActivity = chrono::steady_clock::now();
+  }
+
+  cout << "Followed " << commandCount << " commands using " 
+       << (follower.isUsingInotify() ? "inotify" : "polling") << "." << endl;
+
+  if(appendedCount > 0) {
+    cout << "Append-to-execution latency: average " << totalLatency / appendedCount
+         << " ms, maximum " << maxLatency << " ms." << endl;
+  }
+
+  return true;
+}
+
+/**
+ * Brings the cached inventory report of every genre up to date, rendering
+ * the genres concurrently on the thread pool.
+ *
+ * @return The reports in the order they are displayed: classics, 
+ *         comedies, then dramas.
+ */
+vector<shared_ptr<const string>> Store::refreshInventory() {
+  Trace::Span span("Store::refreshInventory");
+  vector<shared_ptr<const string>> reports(3);
+  ThreadPool::TaskGroup group(runtime);
+
+  group.run([this, &reports] { 
+    reports[0] = classicInventory.refresh(classicTree, runtime); 
+  });
+
+  group.run([this, &reports] { 
+    reports[1] = comedyInventory.refresh(comedyTree, runtime); 
+  });
+
+  reports[2] = dramaInventory.refresh(dramaTree, runtime);
+  group.wait();
+  return reports;
+}
+
+/**
+ * Executes a single transaction by switching on its type.
+ * Borrow and return transactions update the movie and customer they were 
+ * resolved to, history transactions display their customer's history, 
+ * inventory transactions display the movie trees from their cached reports, 
+ * and stats transactions display the Store's memory usage and command 
+ * statistics. Each transaction is counted, and sampled for its latency, 
+ * in the Store's CommandStats.
+ *
+ * @param transaction The Transaction to execute.
+ */
+void Store::executeTransaction(const Transaction &transaction) {
+  CommandStats::Sample sample(commandStats, transaction.getTransType(), 
+    transaction.getGenreOfMovie());
+  Trace::Span span(getSpanName(transaction.getTransType()));
+
+  switch(transaction.getTransType()) {
+    case 'B':
+    case 'R': {
+      stats.stockUpdates += transaction.isResolved();
+
+      if(transaction.getTransType() == 'B') {
+        Borrow::execute(transaction);
+
+      } else {
+          Return::execute(transaction);
+      }
+
+      break;
+    }
+
+    case 'H': {
+      PerfCounters::Phase phase("report history");
+      History::execute(transaction);
+      break;
     }
+
+    case 'I': {
+      PerfCounters::Phase phase("report inventory");
+      for(const shared_ptr<const string> &report : refreshInventory()) {
+        Inventory::execute(*report);
+      }
+
+      break;
+    }
+
+    case 'S': {
+      ReportWriter::StreamSink console(cout);
+      ReportWriter out(console);
+      getMemoryStats().display(out);
+      commandStats.display(out);
+      break;
+    }
+
+    default:
+      Log::write(Log::UnknownTransactionType, transaction.getTransType());
+      break;
+  }
+}
+
+/**
+ * Returns the name a transaction's execution is traced under.
+ *
+ * @param transType The transaction type.
+ * @return The span name, a string literal.
+ */
+const char *Store::getSpanName(char transType) {
+  switch(transType) {
+    case 'B':
+      return "execute B";
+
+    case 'R':
+      return "execute R";
+
+    case 'H':
+      return "execute H";
+
+    case 'I':
+      return "execute I";
+
+    case 'S':
+      return "execute S";
+
+    default:
+      return "execute";
+  }
+}
+
+/**
+ * Returns the movie tree holding the given genre.
+ *
+ * @param genre The genre code ('C' for Classic, 'D' for Drama, 'F' for Comedy).
+ * @return A pointer to the matching MovieTree, or nullptr if the genre is unknown.
+ */
+MovieTree* Store::getTreeForGenre(char genre) {
+  switch(genre) {
+    case 'C':
+      return &classicTree;
+
+    case 'D':
+      return &dramaTree;
+
+    case 'F':
+      return &comedyTree;
+
+    default:
+      return nullptr;
   }
 }
 
@@ -409,19 +1363,16 @@ void Store::processTransactions() {
  * 
  * This method performs the following tasks:
  * 1. Clears the customer data structure by calling its `clear` method. This removes all customer records but does not deallocate the memory used for storing the hash table itself.
- * 2. Iterates through the list of transactions, deleting each `Transaction` object. This ensures that the destructor of each `Transaction` is called, releasing any dynamically allocated memory associated with each transaction.
- * 3. Clears the list of transaction pointers, effectively removing all transaction references and allowing the list to be reset or reused.
+ * 2. Clears the contiguous buffer of transactions, which are stored by value and need no individual deallocation.
+ * 3. Clears the pool of interned transaction attributes, invalidating the handles held by the cleared transactions.
  * 
  * This method is intended to free up memory and clean up resources when the `Store` object is no longer needed or before it is destroyed.
  */
 void Store::cleanup() {
   customers.clear();
-
-  for(Transaction* transaction : transactions) {
-    delete transaction;  // Calls the destructor for each Transaction
-  }
-    
-  transactions.clear(); 
+  transactions.clear();
+  resolvedMovies.clear();
+  attributes.clear();
 }
 
 /**
@@ -28,37 +28,116 @@
 #include "Inventory.h"
 #include "Return.h"
 #include "HashTable.h"
+#include "StringPool.h"
 #include "MovieFactory.h"
 #include "TransactionFactory.h"
+#include "FileFollower.h"
+#include "LineReader.h"
+#include "ThreadPool.h"
+#include "Log.h"
+#include "Arena.h"
+#include "StockTable.h"
+#include "LatencyHistogram.h"
+#include "CommandStats.h"
+#include "Trace.h"
+#include "PerfCounters.h"
+#include <climits>
 #include <fstream>
+#include <functional>
+#include <map>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 using namespace std;
 
 class Store {
 public:
-  Store();
+  struct ExecutionStats {
+    long long movieLookups = 0;   // movie tree searches made while preparing
+    long long stockUpdates = 0;   // writes to a movie's stock count
+  };
+
+  struct LoadStats {
+    double movieMilliseconds = 0;
+    double customerMilliseconds = 0;    // read alongside the movies
+    double transactionMilliseconds = 0;
+  };
+
+  Store(bool useArena = true);
   ~Store();
   bool loadData(const string &, const string &, const string &);
+  bool loadCatalog(const string &, const string &);
   void processTransactions();
+  void processTransactions(map<char, LatencyHistogram> &);
+  void processTransactionsByGenre();
+  void processTransactionsInWaves();
+  void processTransactionsCoalesced();
+  ExecutionStats getExecutionStats() const;
+  LoadStats getLoadStats() const;
+  MemoryStats getMemoryStats() const;
+  ThreadPool &getRuntime();
+  bool executeCommand(const string &);
+  bool executeCommand(const string &, function<void(ostream &)> &, 
+    vector<shared_ptr<const string>> &);
+  bool followTransactions(const string &, int);
 
 private:
+  // benchmarks/ParserBenchmarks times the parsers below directly.
+  friend class ParserBenchmarks;
+  static const size_t linesPerLoadBlock = 65536;   // lines parsed before they are inserted
+
+  // One genre's running stock counts while a batch is coalesced, indexed
+  // by stock ID, and the IDs counted so far in the batch.
+  struct StockScratch {
+    StockTable *table;
+    vector<int> counts;
+    vector<unsigned> touched;
+  };
+  static const int unloaded = INT_MIN;   // a scratch count not yet read from its table
+
+  ThreadPool runtime;
+  bool usesArena;
+  Arena movieArena;
+  Arena customerArena;
+  StringPool movieNames;
   MovieTree classicTree;
   MovieTree comedyTree;
   MovieTree dramaTree;
+  StockTable classicStock;
+  StockTable comedyStock;
+  StockTable dramaStock;
+  InventoryCache classicInventory;
+  InventoryCache comedyInventory;
+  InventoryCache dramaInventory;
   HashTable customers;
-  vector<Transaction*> transactions;
+  StringPool attributes;
+  vector<Transaction> transactions;
+  unordered_map<long long, Movie*> resolvedMovies;
+  ExecutionStats stats;
+  LoadStats loadStats;
+  CommandStats commandStats;
 
-  void parseMovieData(const string &);
+  Movie* parseMovieData(const string &, int &);
+  void addMovie(Movie *, int);
   Customer* parseCustomerData(const string &);
-  Transaction* parseTransactionData(const string &);
-  Transaction* parseBorrowOrReturnTransaction(istringstream &, char, int, char, char);
+  bool parseTransactionData(const string &, Transaction &);
+  bool parseBorrowOrReturnTransaction(istringstream &, char, int, char, char, Transaction &);
+  void prepareTransaction(Transaction &);
+  Movie* resolveMovie(char, const string &, const string &);
+  void executeTransaction(const Transaction &);
+  vector<shared_ptr<const string>> refreshInventory();
+  MovieTree* getTreeForGenre(char);
+  static const char *getSpanName(char);
+  void recordTransaction(const Transaction &, bool, const Customer::HistoryEntry &);
+  void applyGenreBatch(const vector<size_t> &, vector<char> &, vector<Customer::HistoryEntry> &);
+  void executeInWaves(size_t, size_t, vector<char> &);
+  void executeCoalesced(size_t, size_t, vector<char> &, vector<StockScratch> &);
   string trim(const string &);
-  bool parseClassicMovies(int, const string &, const string &, const string &);
+  Movie* parseClassicMovies(const string &, const string &, const string &);
   bool readMovies(const string &);
   bool readTransactions(const string &);
-  bool readCustomers(const string &);
+  bool readCustomers(const string &, ostream &);
   void cleanup();
 
 };
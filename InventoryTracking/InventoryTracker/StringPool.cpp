@@ -0,0 +1,105 @@
+/**
+ * StringPool - a table that stores each distinct string exactly once.
+ *
+ * Strings handed to `intern` are copied into the pool the first time they
+ * are seen and identified afterwards by a small integer handle. Equal strings
+ * always receive the same handle, so callers can store and compare handles
+ * instead of carrying their own copies of the text.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "StringPool.h"
+using namespace std;
+
+/**
+ * Class constructor
+ */
+StringPool::StringPool() {}
+
+/**
+ * Returns the handle for the given string, adding it to the pool if it
+ * has not been seen before.
+ *
+ * @param value The string to intern.
+ * @return The handle identifying the pooled copy of the string.
+ */
+int StringPool::intern(const string &value) {
+  auto found = handles.find(value);
+
+  if(found != handles.end()) {
+    return found->second;
+  }
+
+  // The deque never moves its strings, so the key can view the pooled copy.
+  int handle = static_cast<int>(strings.size());
+  strings.push_back(value);
+  handles.emplace(strings.back(), handle);
+  return handle;
+}
+
+/**
+ * Returns the handle for the given string without adding it to the pool,
+ * so it is safe to call while other threads read the pool.
+ *
+ * @param value The string to look up.
+ * @return The handle of the pooled copy, or -1 if the string is not pooled.
+ */
+int StringPool::find(const string &value) const {
+  auto found = handles.find(value);
+  return found != handles.end() ? found->second : -1;
+}
+
+/**
+ * Retrieves the string identified by a handle. References stay valid
+ * until the pool is cleared, since the underlying deque never relocates
+ * its elements when it grows.
+ *
+ * @param handle A handle previously returned by `intern`.
+ * @return The pooled string.
+ */
+const string &StringPool::get(int handle) const {
+  return strings[handle];
+}
+
+/**
+ * Returns the number of distinct strings in the pool.
+ *
+ * @return The pool size.
+ */
+int StringPool::size() const {
+  return static_cast<int>(strings.size());
+}
+
+/**
+ * Adds the memory of the pool to a breakdown: each string is stored once 
+ * in the pool, and every string has a hash table node holding a view of 
+ * it, its handle, a link and a cached hash.
+ *
+ * @param stats The breakdown to add to.
+ * @param subsystem The subsystem the pool's strings belong to.
+ */
+void StringPool::accountMemory(MemoryStats &stats, MemoryStats::Subsystem subsystem) const {
+  long long bytes = handles.bucket_count() * sizeof(void*) + strings.size() * 
+    (sizeof(string) + sizeof(pair<const string_view, int>) + sizeof(void*) + sizeof(size_t));
+
+  for(const string &value : strings) {
+    bytes += MemoryStats::heapBytes(value);
+  }
+
+  stats.add(subsystem, bytes, strings.size());
+}
+
+/**
+ * Removes every string from the pool, invalidating all handles.
+ */
+void StringPool::clear() {
+  handles.clear();
+  strings.clear();
+}
+
+/**
+ * Class Destructor
+ */
+StringPool::~StringPool() {}
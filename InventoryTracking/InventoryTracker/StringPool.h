@@ -0,0 +1,38 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+/**
+ * StringPool - a table that stores each distinct string exactly once.
+ *
+ * Strings handed to `intern` are copied into the pool the first time they
+ * are seen and identified afterwards by a small integer handle. Equal strings
+ * always receive the same handle, so callers can store and compare handles
+ * instead of carrying their own copies of the text.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "MemoryStats.h"
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+using namespace std;
+
+class StringPool {
+public:
+  StringPool();
+  int intern(const string &);
+  int find(const string &) const;
+  const string &get(int) const;
+  int size() const;
+  void accountMemory(MemoryStats &, MemoryStats::Subsystem) const;
+  void clear();
+  ~StringPool();
+
+private:
+  deque<string> strings;
+  unordered_map<string_view, int> handles;    // keys view the pooled strings
+};
+#endif // STRINGPOOL_H
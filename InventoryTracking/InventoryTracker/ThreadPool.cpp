@@ -0,0 +1,336 @@
+/**
+ * ThreadPool - a work-stealing task scheduler shared by every parallel
+ * part of the Store.
+ *
+ * Each worker thread has its own double-ended task queue. Tasks submitted
+ * from a worker go onto that worker's queue and are taken back newest-first,
+ * which keeps forked work on the thread whose caches already hold its data.
+ * Tasks submitted from other threads are spread across the queues in turn.
+ * A worker whose queue is empty steals the oldest task from another worker.
+ *
+ * TaskGroup provides fork/join: tasks forked through a group can be waited
+ * for together, and a thread waiting on a group runs queued tasks instead of
+ * idling, so groups may be nested inside tasks. `parallelFor` splits an
+ * index range into chunks and runs them as one group. Task counts, steals
+ * and busy time are collected for tuning.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "ThreadPool.h"
+using namespace std;
+
+namespace {
+  // The pool and queue index of the worker running on this thread, if any.
+  thread_local const ThreadPool *workerPool = nullptr;
+  thread_local int workerIndex = -1;
+}
+
+/**
+ * Constructs the pool and starts its worker threads.
+ *
+ * @param threads The number of worker threads, or 0 to use one per 
+ *                hardware thread.
+ */
+ThreadPool::ThreadPool(int threads)
+  : nextQueue(0), queued(0), pending(0), stopped(false),
+    statsStart(chrono::steady_clock::now()) {
+  if(threads <= 0) {
+    threads = max(1u, thread::hardware_concurrency());
+  }
+
+  for(int i = 0; i < threads; i++) {
+    workers.push_back(unique_ptr<Worker>(new Worker()));
+  }
+
+  for(int i = 0; i < threads; i++) {
+    workers[i]->handle = thread(&ThreadPool::run, this, i);
+  }
+}
+
+/**
+ * Queues a task. From a worker thread the task goes onto that worker's own
+ * queue; from any other thread it goes onto the next queue in turn.
+ *
+ * @param task The task to run.
+ */
+void ThreadPool::submit(function<void()> task) {
+  int index = currentWorker();
+
+  if(index < 0) {
+    index = static_cast<int>(nextQueue++ % workers.size());
+  }
+
+  pending++;
+
+  {
+    lock_guard<mutex> lock(workers[index]->queueLock);
+    workers[index]->tasks.push_back(move(task));
+  }
+
+  queued++;
+
+  {
+    lock_guard<mutex> lock(sleepLock);
+  }
+
+  wakeUp.notify_one();
+}
+
+/**
+ * Blocks until every task submitted to the pool has finished running.
+ * Must not be called from inside a task; use a TaskGroup there instead.
+ */
+void ThreadPool::wait() {
+  unique_lock<mutex> lock(sleepLock);
+  idle.wait(lock, [this] { return pending == 0; });
+}
+
+/**
+ * Runs `body` over the index range [begin, end) split into chunks of at 
+ * most `grain` indices, in parallel, and returns once all chunks are done.
+ * The calling thread runs chunks too while it waits.
+ *
+ * @param begin The first index of the range.
+ * @param end One past the last index of the range.
+ * @param grain The largest number of indices handed to one call of `body`.
+ * @param body Called with the bounds [first, last) of each chunk.
+ */
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grain,
+  const function<void(size_t, size_t)> &body) {
+  if(begin >= end) {
+    return;
+  }
+
+  grain = max<size_t>(grain, 1);
+
+  if(end - begin <= grain) {
+    body(begin, end);
+    return;
+  }
+
+  TaskGroup group(*this);
+
+  for(size_t first = begin; first < end; first += grain) {
+    size_t last = min(end, first + grain);
+    group.run([&body, first, last] { body(first, last); });
+  }
+
+  group.wait();
+}
+
+/**
+ * Returns the number of worker threads in the pool.
+ *
+ * @return The pool's thread count.
+ */
+int ThreadPool::size() const {
+  return static_cast<int>(workers.size());
+}
+
+/**
+ * Returns the pool's activity since it was created or its statistics were
+ * last reset.
+ *
+ * @return The number of tasks executed and stolen, and the time spent 
+ *         running tasks compared to the time elapsed.
+ */
+ThreadPool::Stats ThreadPool::getStats() const {
+  Stats stats;
+  stats.threads = size();
+  stats.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - statsStart).count();
+
+  for(const unique_ptr<Worker> &worker : workers) {
+    stats.tasksExecuted += worker->tasksExecuted;
+    stats.steals += worker->steals;
+    stats.busySeconds += worker->busyNanoseconds / 1e9;
+  }
+
+  return stats;
+}
+
+/**
+ * Clears the pool's statistics so that a new phase can be measured.
+ */
+void ThreadPool::resetStats() {
+  for(unique_ptr<Worker> &worker : workers) {
+    worker->tasksExecuted = 0;
+    worker->steals = 0;
+    worker->busyNanoseconds = 0;
+  }
+
+  statsStart = chrono::steady_clock::now();
+}
+
+/**
+ * Returns the fraction of the workers' available time spent running tasks.
+ *
+ * @return A value between 0 and 1.
+ */
+double ThreadPool::Stats::utilization() const {
+  return threads > 0 && elapsedSeconds > 0 ? busySeconds / (threads * elapsedSeconds) : 0.0;
+}
+
+/**
+ * Returns the index of the worker running on the calling thread.
+ *
+ * @return The worker's queue index, or -1 if the caller is not one of 
+ *         this pool's workers.
+ */
+int ThreadPool::currentWorker() const {
+  return workerPool == this ? workerIndex : -1;
+}
+
+/**
+ * Runs one queued task if there is any: the newest task on the given 
+ * worker's own queue, or failing that the oldest task on another queue.
+ *
+ * @param self The queue index of the calling worker, or -1 for a thread 
+ *             outside the pool, which can only steal.
+ * @return true if a task was run; false if every queue was empty.
+ */
+bool ThreadPool::runOneTask(int self) {
+  function<void()> task;
+  int count = size();
+  bool stolen = false;
+
+  if(self >= 0) {
+    lock_guard<mutex> lock(workers[self]->queueLock);
+
+    if(!workers[self]->tasks.empty()) {
+      task = move(workers[self]->tasks.back());
+      workers[self]->tasks.pop_back();
+    }
+  }
+
+  for(int i = 1; !task && i <= count; i++) {
+    Worker &victim = *workers[(max(self, 0) + i) % count];
+    lock_guard<mutex> lock(victim.queueLock);
+
+    if(!victim.tasks.empty()) {
+      task = move(victim.tasks.front());
+      victim.tasks.pop_front();
+      stolen = self >= 0;
+    }
+  }
+
+  if(!task) {
+    return false;
+  }
+
+  queued--;
+  auto start = chrono::steady_clock::now();
+  task();
+
+  if(self >= 0) {
+    Worker &worker = *workers[self];
+    worker.busyNanoseconds += chrono::duration_cast<chrono::nanoseconds>(
+      chrono::steady_clock::now() - start).count();
+    worker.tasksExecuted++;
+    worker.steals += stolen;
+  }
+
+  if(--pending == 0) {
+    lock_guard<mutex> lock(sleepLock);
+    idle.notify_all();
+  }
+
+  return true;
+}
+
+/**
+ * Body of each worker thread. Runs tasks from its own queue or stolen 
+ * from others, and sleeps while every queue is empty, until the pool 
+ * is destroyed.
+ *
+ * @param index The worker's queue index.
+ */
+void ThreadPool::run(int index) {
+  workerPool = this;
+  workerIndex = index;
+
+  while(true) {
+    if(runOneTask(index)) {
+      continue;
+    }
+
+    unique_lock<mutex> lock(sleepLock);
+    wakeUp.wait(lock, [this] { return stopped || queued > 0; });
+
+    if(stopped && queued == 0) {
+      return;
+    }
+  }
+}
+
+/**
+ * Class Destructor
+ */
+ThreadPool::~ThreadPool() {
+  wait();
+
+  {
+    lock_guard<mutex> lock(sleepLock);
+    stopped = true;
+  }
+
+  wakeUp.notify_all();
+
+  for(unique_ptr<Worker> &worker : workers) {
+    worker->handle.join();
+  }
+}
+
+/**
+ * Constructs an empty group of tasks on the given pool.
+ *
+ * @param taskPool The pool that runs the group's tasks.
+ */
+ThreadPool::TaskGroup::TaskGroup(ThreadPool &taskPool)
+  : pool(taskPool), pending(0) {
+}
+
+/**
+ * Forks a task as part of this group.
+ *
+ * @param task The task to run.
+ */
+void ThreadPool::TaskGroup::run(function<void()> task) {
+  pending++;
+
+  pool.submit([this, task] {
+    task();
+    lock_guard<mutex> lock(doneLock);
+
+    if(--pending == 0) {
+      done.notify_all();
+    }
+  });
+}
+
+/**
+ * Joins the group: returns once every task forked through it has finished.
+ * While waiting, the calling thread runs queued tasks of the pool.
+ */
+void ThreadPool::TaskGroup::wait() {
+  while(pending > 0) {
+    if(pool.runOneTask(pool.currentWorker())) {
+      continue;
+    }
+
+    unique_lock<mutex> lock(doneLock);
+    done.wait_for(lock, chrono::milliseconds(1), [this] { return pending == 0; });
+  }
+
+  // The last task still holds the lock while it signals; let it finish
+  // with the group before the group can be destroyed.
+  lock_guard<mutex> lock(doneLock);
+}
+
+/**
+ * Class Destructor
+ */
+ThreadPool::TaskGroup::~TaskGroup() {
+  wait();
+}
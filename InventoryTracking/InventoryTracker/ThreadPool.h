@@ -0,0 +1,93 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+/**
+ * ThreadPool - a work-stealing task scheduler shared by every parallel
+ * part of the Store.
+ *
+ * Each worker thread has its own double-ended task queue. Tasks submitted
+ * from a worker go onto that worker's queue and are taken back newest-first,
+ * which keeps forked work on the thread whose caches already hold its data.
+ * Tasks submitted from other threads are spread across the queues in turn.
+ * A worker whose queue is empty steals the oldest task from another worker.
+ *
+ * TaskGroup provides fork/join: tasks forked through a group can be waited
+ * for together, and a thread waiting on a group runs queued tasks instead of
+ * idling, so groups may be nested inside tasks. `parallelFor` splits an
+ * index range into chunks and runs them as one group. Task counts, steals
+ * and busy time are collected for tuning.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+class ThreadPool {
+public:
+  class TaskGroup {
+  public:
+    TaskGroup(ThreadPool &);
+    void run(function<void()>);
+    void wait();
+    ~TaskGroup();
+
+  private:
+    ThreadPool &pool;
+    atomic<long long> pending;
+    mutex doneLock;
+    condition_variable done;
+  };
+
+  struct Stats {
+    int threads = 0;
+    long long tasksExecuted = 0;
+    long long steals = 0;
+    double busySeconds = 0.0;
+    double elapsedSeconds = 0.0;
+    double utilization() const;
+  };
+
+  ThreadPool(int threads = 0);
+  void submit(function<void()>);
+  void wait();
+  void parallelFor(size_t, size_t, size_t, const function<void(size_t, size_t)> &);
+  int size() const;
+  Stats getStats() const;
+  void resetStats();
+  ~ThreadPool();
+
+private:
+  struct Worker {
+    mutex queueLock;
+    deque<function<void()>> tasks;
+    thread handle;
+    atomic<long long> tasksExecuted{0};
+    atomic<long long> steals{0};
+    atomic<long long> busyNanoseconds{0};
+  };
+
+  vector<unique_ptr<Worker>> workers;
+  atomic<size_t> nextQueue;
+  atomic<long long> queued;
+  atomic<long long> pending;
+  mutex sleepLock;
+  condition_variable wakeUp;
+  condition_variable idle;
+  bool stopped;
+  chrono::steady_clock::time_point statsStart;
+
+  int currentWorker() const;
+  bool runOneTask(int);
+  void run(int);
+};
+#endif // THREADPOOL_H
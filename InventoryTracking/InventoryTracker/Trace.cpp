@@ -0,0 +1,199 @@
+/**
+ * Trace - scoped timing spans recorded in the Chrome trace event format,
+ * for finding which phase of a load or replay is slow.
+ *
+ * A Span marks the scope it is declared in: while tracing is on, it notes
+ * when it was created and, when destroyed, appends its name, start and
+ * duration to a buffer belonging to the current thread, so threads never
+ * contend while recording and spans on the thread pool are kept apart by
+ * thread. While tracing is off a Span only checks a flag. When the trace
+ * is saved, every thread's buffer is written as one JSON file that 
+ * chrome://tracing and ui.perfetto.dev open, with nested spans shown 
+ * inside one another on each thread's row.
+ *
+ * Span names must be string literals, or otherwise outlive the trace. 
+ * A trace must be saved when no spans are open on other threads.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "Trace.h"
+#include "Log.h"
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+using namespace std;
+
+atomic<bool> Trace::recording(false);
+thread_local Trace::Buffer *Trace::currentBuffer = nullptr;
+
+/**
+ * Starts a span named after the enclosing scope.
+ *
+ * @param theName The span's name; it must outlive the trace.
+ */
+Trace::Span::Span(const char *theName) : name(theName), started(-1) {
+  if(recording.load(memory_order_acquire)) {
+    started = now();
+  }
+}
+
+/**
+ * Class Destructor
+ * Ends the span, recording it in this thread's buffer if it was started 
+ * while tracing.
+ */
+Trace::Span::~Span() {
+  if(started >= 0) {
+    threadBuffer().events.push_back(Event{name, started, now() - started});
+  }
+}
+
+/**
+ * Starts tracing if a file is given; the trace is saved to it when the 
+ * Recording is destroyed.
+ *
+ * @param theFileName The file to save the trace to, or an empty string to 
+ *                    leave tracing off.
+ */
+Trace::Recording::Recording(const string &theFileName) : fileName(theFileName) {
+  if(!fileName.empty()) {
+    start();
+  }
+}
+
+/**
+ * Class Destructor
+ * Saves the trace, if one was started.
+ */
+Trace::Recording::~Recording() {
+  if(!fileName.empty() && !save(fileName)) {
+    Log::write(Log::TraceWriteFailed, fileName);
+    Log::flush();
+  }
+}
+
+/**
+ * Starts tracing. The calling thread's row is named "main" in the trace, 
+ * and times are measured from now.
+ */
+void Trace::start() {
+  Trace &trace = instance();
+  trace.origin = chrono::steady_clock::now();
+  threadBuffer().threadName = "main";
+  recording.store(true, memory_order_release);
+}
+
+/**
+ * Stops tracing and writes every span recorded so far to a file as a 
+ * Chrome trace, then discards them.
+ *
+ * @param fileName The file to write.
+ * @return false if the file could not be written; true otherwise.
+ */
+bool Trace::save(const string &fileName) {
+  recording.store(false, memory_order_relaxed);
+  ofstream output(fileName);
+
+  if(!output) {
+    return false;
+  }
+
+  instance().write(output);
+  return bool(output);
+}
+
+/**
+ * Reports whether spans are being recorded.
+ *
+ * @return true while tracing is on.
+ */
+bool Trace::isRecording() {
+  return recording.load(memory_order_relaxed);
+}
+
+/**
+ * Class constructor
+ */
+Trace::Trace() : origin(chrono::steady_clock::now()) {
+}
+
+/**
+ * Returns the trace shared by the whole program.
+ *
+ * @return The trace.
+ */
+Trace &Trace::instance() {
+  static Trace trace;
+  return trace;
+}
+
+/**
+ * Returns the time since tracing started.
+ *
+ * @return The time in nanoseconds.
+ */
+long long Trace::now() {
+  return chrono::duration_cast<chrono::nanoseconds>(
+    chrono::steady_clock::now() - instance().origin).count();
+}
+
+/**
+ * Returns the calling thread's buffer, creating it the first time the 
+ * thread records a span.
+ *
+ * @return The buffer.
+ */
+Trace::Buffer &Trace::threadBuffer() {
+  if(currentBuffer == nullptr) {
+    Trace &trace = instance();
+    lock_guard<mutex> guard(trace.buffersLock);
+    int thread = trace.buffers.size() + 1;
+    trace.buffers.push_back(unique_ptr<Buffer>(new Buffer{thread, "thread " + to_string(thread), {}}));
+    currentBuffer = trace.buffers.back().get();
+  }
+
+  return *currentBuffer;
+}
+
+/**
+ * Writes the recorded spans as a Chrome trace: a name for each thread's 
+ * row, then a complete event for each span, with times in microseconds.
+ * The spans are discarded once written.
+ *
+ * @param out The stream to write the trace to.
+ */
+void Trace::write(ostream &out) {
+  lock_guard<mutex> guard(buffersLock);
+  int process = getpid();
+  const char *separator = "\n";
+  char event[256];
+
+  out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+
+  for(const unique_ptr<Buffer> &buffer : buffers) {
+    out << separator << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << process 
+        << ", \"tid\": " << buffer->thread << ", \"args\": {\"name\": \"" 
+        << buffer->threadName << "\"}}";
+    separator = ",\n";
+  }
+
+  for(const unique_ptr<Buffer> &buffer : buffers) {
+    for(const Event &span : buffer->events) {
+      snprintf(event, sizeof(event), "%s{\"name\": \"%s\", \"cat\": \"store\", \"ph\": \"X\", "
+        "\"ts\": %.3f, \"dur\": %.3f, \"pid\": %d, \"tid\": %d}", separator, span.name, 
+        span.start / 1000.0, span.duration / 1000.0, process, buffer->thread);
+      out << event;
+    }
+
+    buffer->events.clear();
+  }
+
+  out << "\n]}\n";
+}
+
+/**
+ * Class Destructor
+ */
+Trace::~Trace() {}
@@ -0,0 +1,85 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/**
+ * Trace - scoped timing spans recorded in the Chrome trace event format,
+ * for finding which phase of a load or replay is slow.
+ *
+ * A Span marks the scope it is declared in: while tracing is on, it notes
+ * when it was created and, when destroyed, appends its name, start and
+ * duration to a buffer belonging to the current thread, so threads never
+ * contend while recording and spans on the thread pool are kept apart by
+ * thread. While tracing is off a Span only checks a flag. When the trace
+ * is saved, every thread's buffer is written as one JSON file that 
+ * chrome://tracing and ui.perfetto.dev open, with nested spans shown 
+ * inside one another on each thread's row.
+ *
+ * Span names must be string literals, or otherwise outlive the trace. 
+ * A trace must be saved when no spans are open on other threads.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+class Trace {
+public:
+  class Span {
+  public:
+    Span(const char *);
+    ~Span();
+
+  private:
+    const char *name;
+    long long started;    // nanoseconds into the trace, or -1 if not recording
+  };
+
+  class Recording {
+  public:
+    Recording(const string &);
+    ~Recording();
+
+  private:
+    string fileName;
+  };
+
+  static void start();
+  static bool save(const string &);
+  static bool isRecording();
+
+private:
+  struct Event {
+    const char *name;
+    long long start;
+    long long duration;
+  };
+
+  struct Buffer {
+    int thread;
+    string threadName;
+    vector<Event> events;
+  };
+
+  static atomic<bool> recording;
+  static thread_local Buffer *currentBuffer;   // once this thread has recorded a span
+
+  chrono::steady_clock::time_point origin;
+  mutex buffersLock;
+  vector<unique_ptr<Buffer>> buffers;
+
+  Trace();
+  static Trace &instance();
+  static long long now();
+  static Buffer &threadBuffer();
+  void write(ostream &);
+  ~Trace();
+};
+#endif // TRACE_H
@@ -1,39 +1,60 @@
 /**
- * Transaction - Abstract base class for representing various types of transactions.
+ * Transaction - Compact value type representing a single parsed command.
  * 
- * This class provides a common interface and shared attributes for different 
- * transaction types, such as borrowing and returning movies. It includes
- * attributes for customer ID, media type, movie type, and movie title, and 
- * declares a pure virtual function `execute()` that must be implemented by
- * derived classes to perform the specific actions associated with the transaction.
+ * Every transaction type (borrow, return, history and inventory) shares this
+ * one representation so that a command stream can be stored by value in a
+ * single contiguous buffer. The free-text attributes of borrow and return
+ * commands are not stored inline; they are interned into a StringPool and
+ * referenced here by handle. Execution is dispatched on the transaction type
+ * by the Store rather than through a virtual function.
+ * 
+ * When a transaction is parsed the Store also prepares it, resolving the 
+ * customer and movie it refers to into direct handles. Execution then only 
+ * touches those handles; a null handle flags a customer or movie that did 
+ * not exist when the transaction was prepared. A movie is held as its 
+ * entry in its genre's StockTable, so a borrow or return updates the stock
+ * count without reading the Movie itself.
  * 
  * Nolan Dela Rosa
  * 
  * August 12, 2024
  */
 #include "Transaction.h"
+#include "Movie.h"
+#include "StockTable.h"
 using namespace std;
 
 /**
  * Default constructor for the Transaction class.
  * 
- * Initializes a Transaction object with a default value:
- * - transType: ' ' (empty space)
+ * Initializes a Transaction object with default values:
+ * - transType, mediaType, genreOfMovie: ' ' (empty space)
+ * - customerID: 0
+ * - attribute1, attribute2: -1 (no interned attribute)
+ * - customer, stockTable: nullptr (not yet resolved)
  */
 Transaction::Transaction() 
-  : transType(' '), genreOfMovie(' '),
-    customerID(0) {
+  : transType(' '), mediaType(' '), genreOfMovie(' '),
+    customerID(0), attribute1(-1), attribute2(-1),
+    stockId(0), customer(nullptr), stockTable(nullptr) {
 }
 
 /**
  * Parameterized constructor for the Transaction class.
  * 
  * Initializes a Transaction object with the given values:
- * @param trans  The transaction type being made.
+ * @param trans The transaction type being made.
+ * @param ID The unique ID number of the customer making the transaction.
+ * @param media A character representing the type of media involved.
+ * @param genre A character representing the genre of the movie involved.
+ * @param data1 Handle of the first interned attribute, or -1 if unused.
+ * @param data2 Handle of the second interned attribute, or -1 if unused.
  */
-Transaction::Transaction(char trans, char genre, int ID)
-  : transType(trans), genreOfMovie(genre),
-    customerID(ID) {
+Transaction::Transaction(char trans, int ID, char media, char genre,
+  int data1, int data2)
+  : transType(trans), mediaType(media), genreOfMovie(genre),
+    customerID(ID), attribute1(data1), attribute2(data2),
+    stockId(0), customer(nullptr), stockTable(nullptr) {
 }
 
 /**
@@ -45,6 +66,15 @@ char Transaction::getTransType() const {
   return transType;
 }
 
+/**
+ * Return the media type involved in this transaction.
+ * 
+ * @return The media type, as a char.
+ */
+char Transaction::getMediaType() const {
+  return mediaType;
+}
+
 /**
  * Return the ID for Customer involved in this
  * transaction.
@@ -66,6 +96,98 @@ char Transaction::getGenreOfMovie() const {
 }
 
 /**
- * Class Destructor
+ * Returns the handle of the first interned attribute 
+ * (release date, director or title depending on the genre).
+ * 
+ * @return A StringPool handle, or -1 if the transaction has none.
+ */
+int Transaction::getAttribute1() const {
+  return attribute1;
+}
+
+/**
+ * Returns the handle of the second interned attribute 
+ * (actor, title or release year depending on the genre).
+ * 
+ * @return A StringPool handle, or -1 if the transaction has none.
  */
-Transaction::~Transaction() {}
\ No newline at end of file
+int Transaction::getAttribute2() const {
+  return attribute2;
+}
+
+/**
+ * Returns the Customer this transaction was resolved to.
+ * 
+ * @return A pointer to the Customer, or nullptr if the customer 
+ * could not be found when the transaction was prepared.
+ */
+Customer* Transaction::getCustomer() const {
+  return customer;
+}
+
+/**
+ * Returns the Movie this transaction was resolved to.
+ * 
+ * @return A pointer to the Movie, or nullptr if the transaction does 
+ * not refer to a movie or the movie could not be found when the 
+ * transaction was prepared.
+ */
+Movie* Transaction::getMovie() const {
+  return stockTable != nullptr ? stockTable->getMovie(stockId) : nullptr;
+}
+
+/**
+ * Returns the StockTable holding the stock count of the movie this 
+ * transaction was resolved to.
+ * 
+ * @return The table, or nullptr if the transaction has no resolved movie.
+ */
+StockTable* Transaction::getStockTable() const {
+  return stockTable;
+}
+
+/**
+ * Returns the stock ID of the movie this transaction was resolved to.
+ * 
+ * @return The movie's entry in `getStockTable()`.
+ */
+unsigned Transaction::getStockId() const {
+  return stockId;
+}
+
+/**
+ * Reports whether every entity this transaction refers to was found
+ * when it was prepared. Borrow and return transactions need both a 
+ * customer and a movie, history transactions only a customer, and 
+ * inventory transactions need neither.
+ * 
+ * @return true if the transaction can be executed without errors 
+ * from missing customers or movies; false otherwise.
+ */
+bool Transaction::isResolved() const {
+  switch(transType) {
+    case 'B':
+    case 'R':
+      return customer != nullptr && stockTable != nullptr;
+
+    case 'H':
+      return customer != nullptr;
+
+    default:
+      return true;
+  }
+}
+
+/**
+ * Records the customer and movie this transaction refers to.
+ * 
+ * @param theCustomer The resolved Customer, or nullptr if it was not found.
+ * @param theMovie The resolved Movie, or nullptr if it was not found or unused.
+ *                 Only a movie whose stock is kept in a StockTable counts 
+ *                 as found.
+ */
+void Transaction::resolve(Customer* theCustomer, Movie* theMovie) {
+  customer = theCustomer;
+  stockTable = theMovie != nullptr ? theMovie->getStockTable() : nullptr;
+  stockId = theMovie != nullptr ? theMovie->getStockId() : 0;
+}
@@ -2,13 +2,21 @@
 #define TRANSACTION_H
 
 /**
- * Transaction - Abstract base class for representing various types of transactions.
+ * Transaction - Compact value type representing a single parsed command.
  * 
- * This class provides a common interface and shared attributes for different 
- * transaction types, such as borrowing and returning movies. It includes
- * attributes for customer ID, media type, movie type, and movie title, and 
- * declares a pure virtual function `execute()` that must be implemented by
- * derived classes to perform the specific actions associated with the transaction.
+ * Every transaction type (borrow, return, history and inventory) shares this
+ * one representation so that a command stream can be stored by value in a
+ * single contiguous buffer. The free-text attributes of borrow and return
+ * commands are not stored inline; they are interned into a StringPool and
+ * referenced here by handle. Execution is dispatched on the transaction type
+ * by the Store rather than through a virtual function.
+ * 
+ * When a transaction is parsed the Store also prepares it, resolving the 
+ * customer and movie it refers to into direct handles. Execution then only 
+ * touches those handles; a null handle flags a customer or movie that did 
+ * not exist when the transaction was prepared. A movie is held as its 
+ * entry in its genre's StockTable, so a borrow or return updates the stock
+ * count without reading the Movie itself.
  * 
  * Nolan Dela Rosa
  * 
@@ -16,29 +24,39 @@
  */
 #include <iostream>
 #include <string>
-#include <vector>
-#include <unordered_map>
-#include "HashTable.h"
-#include "Customer.h"
 using namespace std;
 
-class MovieTree;
-class HashTable;
+class Customer;
+class Movie;
+class StockTable;
 
 class Transaction {
 public:
   Transaction();
-  Transaction(char, char, int);
+  Transaction(char, int, char, char, int, int);
   char getGenreOfMovie() const;
   char getTransType() const;
+  char getMediaType() const;
   int getCustomerID() const;
-  virtual void execute(MovieTree &, HashTable &) = 0;
-  virtual ~Transaction();
+  int getAttribute1() const;
+  int getAttribute2() const;
+  Customer* getCustomer() const;
+  Movie* getMovie() const;
+  StockTable* getStockTable() const;
+  unsigned getStockId() const;
+  bool isResolved() const;
+  void resolve(Customer*, Movie*);
 
-protected:
+private:
   char transType;
+  char mediaType;
   char genreOfMovie;
   int customerID;
+  int attribute1;
+  int attribute2;
+  unsigned stockId;
+  Customer* customer;
+  StockTable* stockTable;
 };
 
-#endif // TRANSACTION_H
\ No newline at end of file
+#endif // TRANSACTION_H
@@ -1,8 +1,8 @@
 /**
- * TransactionFactory - A utility class responsible for creating instances of Transaction objects.
+ * TransactionFactory - A utility class responsible for creating Transaction values.
  * 
- * This class provides a static method to generate specific types of Transaction objects based on
- * a given command type. It centralizes the instantiation logic for different transaction types,
+ * This class provides a static method to generate specific types of Transactions based on
+ * a given command type. It centralizes the construction logic for different transaction types,
  * making it easier to manage and extend the types of transactions supported by the application.
  * 
  * Nolan Dela Rosa
@@ -13,40 +13,39 @@
 using namespace std;
 
 /** 
- * Creates and returns a new Transaction object based on the provided transaction code and parameters.
+ * Creates a Transaction based on the provided transaction code and parameters.
  * The method supports various transaction types including Borrow, History, Inventory, and Return. 
- * Depending on the transaction code, it initializes the respective transaction object with the given 
- * parameters or returns an error message for unknown transaction codes.
+ * Depending on the transaction code, it initializes the transaction with the fields relevant 
+ * to that type or returns an error message for unknown transaction codes.
  *
  * @param trans         A character representing the type of transaction ('B' for Borrow, 'H' for History,
- *                      'I' for Inventory, 'R' for Return).
+ *                      'I' for Inventory, 'R' for Return, 'S' for Stats).
  * @param customerID    An integer representing the ID of the customer involved in the transaction.
- * @param mediaType     A character representing the type of media involved (e.g., 'D' for DVD, 'F' for Film).
- * @param movieType     A character representing the type of movie (e.g., 'C' for Comedy, 'D' for Drama).
- * @param attribute1    A string representing additional attribute 1 relevant to the transaction (e.g., movie title).
- * @param attribute2    A string representing additional attribute 2 relevant to the transaction (e.g., actor name).
+ * @param mediaType     A character representing the type of media involved (e.g., 'D' for DVD).
+ * @param movieType     A character representing the type of movie (e.g., 'F' for Comedy, 'D' for Drama).
+ * @param attribute1    Handle of the interned first attribute (e.g., movie title).
+ * @param attribute2    Handle of the interned second attribute (e.g., actor name).
+ * @param created       Receives the new Transaction when the code is known.
  * 
- * @return A pointer to the created Transaction object, or nullptr if the transaction code is unknown.
+ * @return true if the Transaction was created, or false if the transaction code is unknown.
  */
-Transaction* TransactionFactory::createTransaction(char trans, 
+bool TransactionFactory::createTransaction(char trans, 
   int customerID, char mediaType, char movieType, 
-  const string &attribute1, const string &attribute2) {
-  if(trans == 'B') {
-    return new Borrow(trans, customerID, mediaType, 
+  int attribute1, int attribute2, Transaction &created) {
+  if(trans == 'B' || trans == 'R') {
+    created = Transaction(trans, customerID, mediaType, 
       movieType, attribute1, attribute2);
 
   } else if(trans == 'H') {
-      return new History(trans, movieType, customerID);
+      created = Transaction(trans, customerID, ' ', movieType, -1, -1);
 
-  } else if(trans == 'I') {
-      return new Inventory(trans, ' ', 0);
-
-  } else if(trans == 'R') {
-      return new Return(trans, customerID, mediaType,
-        movieType, attribute1, attribute2);
+  } else if(trans == 'I' || trans == 'S') {
+      created = Transaction(trans, 0, ' ', ' ', -1, -1);
 
   } else {
-      cout << "Error: unknown transaction code " << trans << "." << endl;
-      return nullptr;
+      Log::write(Log::UnknownTransactionCode, trans);
+      return false;
   }
-}
\ No newline at end of file
+
+  return true;
+}
@@ -2,10 +2,10 @@
 #define TRANSACTIONFACTORY_H
 
 /**
- * TransactionFactory - A utility class responsible for creating instances of Transaction objects.
+ * TransactionFactory - A utility class responsible for creating Transaction values.
  * 
- * This class provides a static method to generate specific types of Transaction objects based on
- * a given command type. It centralizes the instantiation logic for different transaction types,
+ * This class provides a static method to generate specific types of Transactions based on
+ * a given command type. It centralizes the construction logic for different transaction types,
  * making it easier to manage and extend the types of transactions supported by the application.
  * 
  * Nolan Dela Rosa
@@ -13,15 +13,11 @@
  * August 13, 2024
  */
 #include "Transaction.h"
-#include "Borrow.h"
-#include "History.h"
-#include "Inventory.h"
-#include "Return.h"
+#include "Log.h"
 using namespace std;
 
 class TransactionFactory {
 public:
-  static Transaction* createTransaction(char, int, char, char, 
-    const string &, const string &);
+  static bool createTransaction(char, int, char, char, int, int, Transaction &);
 };
 #endif // TRANSACTIONFACTORY_H
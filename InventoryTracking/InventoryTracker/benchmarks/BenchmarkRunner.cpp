@@ -0,0 +1,246 @@
+/**
+ * BenchmarkRunner - runs microbenchmarks and reports them as JSON.
+ *
+ * Each benchmark is a function that performs a known number of operations
+ * and marks the part worth timing with its Timer, so setting up data and
+ * tearing it down are left out. The runner calls it a number of times and
+ * keeps the fastest and median time per operation. When every benchmark has
+ * run, the results are written as one JSON document along with the context
+ * they were taken in, so runs can be compared across releases. Where the
+ * hardware counters can be read, each benchmark's timed sections are also
+ * counted, and instructions, IPC, last-level cache misses and branch 
+ * mispredictions per operation are reported alongside its times.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "BenchmarkRunner.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+using namespace std;
+
+/**
+ * Constructs a stopped timer with nothing measured.
+ *
+ * @param theCounters The counters to read while timing, or nullptr to 
+ *                    only measure time.
+ */
+BenchmarkRunner::Timer::Timer(const PerfCounters *theCounters) 
+  : counters(theCounters), elapsed(0) {
+}
+
+/**
+ * Starts measuring.
+ */
+void BenchmarkRunner::Timer::start() {
+  if(counters != nullptr) {
+    startedCounts = counters->read();
+  }
+
+  started = chrono::steady_clock::now();
+}
+
+/**
+ * Stops measuring, adding the time since `start` to the measured time and
+ * what the counters moved to the counts.
+ */
+void BenchmarkRunner::Timer::stop() {
+  elapsed += chrono::duration<double, nano>(chrono::steady_clock::now() - started).count();
+
+  if(counters != nullptr) {
+    counted += counters->read() - startedCounts;
+  }
+}
+
+/**
+ * Returns the time measured between every `start` and `stop`.
+ *
+ * @return The measured time in nanoseconds.
+ */
+double BenchmarkRunner::Timer::elapsedNanoseconds() const {
+  return elapsed;
+}
+
+/**
+ * Returns what the counters moved between every `start` and `stop`.
+ *
+ * @return The counts; all unavailable if no counters were read.
+ */
+const PerfCounters::Reading &BenchmarkRunner::Timer::getCounts() const {
+  return counted;
+}
+
+/**
+ * Constructs a runner.
+ *
+ * @param theRepeats How many times to run each benchmark.
+ * @param theFilter Only benchmarks whose name contains this are run; 
+ *                  empty to run them all.
+ */
+BenchmarkRunner::BenchmarkRunner(int theRepeats, const string &theFilter)
+  : repeats(max(1, theRepeats)), filter(theFilter) {
+}
+
+/**
+ * Runs a benchmark the configured number of times and records the time 
+ * per operation. Progress is written to standard error.
+ *
+ * @param name The benchmark's name, such as "MovieTree/insert".
+ * @param parameters The settings this run of the benchmark used.
+ * @param operations The number of operations one call performs.
+ * @param body Performs the operations, timing them with the given Timer.
+ */
+void BenchmarkRunner::run(const string &name, const Parameters &parameters, 
+  long long operations, const function<void(Timer &)> &body) {
+  if(!filter.empty() && name.find(filter) == string::npos) {
+    return;
+  }
+
+  vector<double> perOperation;
+  Result result;
+
+  for(int i = 0; i < repeats; i++) {
+    Timer timer(counters.isAvailable() ? &counters : nullptr);
+    body(timer);
+    perOperation.push_back(timer.elapsedNanoseconds() / max(1LL, operations));
+    result.counts += timer.getCounts();
+  }
+
+  sort(perOperation.begin(), perOperation.end());
+
+  result.name = name;
+  result.parameters = parameters;
+  result.operations = operations;
+  result.repeats = repeats;
+  result.bestNanoseconds = perOperation.front();
+  result.medianNanoseconds = perOperation[perOperation.size() / 2];
+  results.push_back(result);
+
+  cerr << name;
+  for(const pair<string, string> &parameter : parameters) {
+    cerr << ' ' << parameter.first << '=' << parameter.second;
+  }
+  cerr << ": " << result.medianNanoseconds << " ns/op" << endl;
+}
+
+/**
+ * Returns the results of the benchmarks run so far.
+ *
+ * @return The results, in the order the benchmarks ran.
+ */
+const vector<BenchmarkRunner::Result> &BenchmarkRunner::getResults() const {
+  return results;
+}
+
+/**
+ * Writes the results as a JSON document: the context of the run (time,
+ * compiler, build flags, hardware threads and whether hardware counters 
+ * could be read) and one object per benchmark run. Counts that could not 
+ * be read are null.
+ *
+ * @param out The stream to write the document to.
+ */
+void BenchmarkRunner::writeJson(ostream &out) const {
+#ifdef BENCHMARK_FLAGS
+  const string flags = BENCHMARK_FLAGS;
+#else
+  const string flags = "";
+#endif
+
+  char date[32];
+  time_t now = time(nullptr);
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+  out << "{\n  \"context\": {\n"
+      << "    \"date\": " << quote(date) << ",\n"
+      << "    \"compiler\": " << quote(__VERSION__) << ",\n"
+      << "    \"flags\": " << quote(flags) << ",\n"
+      << "    \"hardware_threads\": " << thread::hardware_concurrency() << ",\n"
+      << "    \"hardware_counters\": " << quote(counters.isAvailable() 
+        ? (counters.getError().empty() ? "available" : "partial (" + counters.getError() + ")")
+        : "unavailable (" + counters.getError() + ")") << ",\n"
+      << "    \"repeats\": " << repeats << "\n  },\n"
+      << "  \"benchmarks\": [";
+
+  for(size_t i = 0; i < results.size(); i++) {
+    const Result &result = results[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\"name\": " << quote(result.name) 
+        << ", \"parameters\": {";
+
+    for(size_t j = 0; j < result.parameters.size(); j++) {
+      out << (j == 0 ? "" : ", ") << quote(result.parameters[j].first) << ": "
+          << quote(result.parameters[j].second);
+    }
+
+    out << "}, \"operations\": " << result.operations 
+        << ", \"best_ns_per_op\": " << result.bestNanoseconds
+        << ", \"median_ns_per_op\": " << result.medianNanoseconds
+        << ", \"ops_per_second\": " << (result.medianNanoseconds > 0 ? 1e9 / result.medianNanoseconds : 0);
+
+    const PerfCounters::Reading &counts = result.counts;
+    long long totalOperations = result.operations * result.repeats;
+    double ipc = counts.ipc();
+    out << ", \"instructions_per_op\": " 
+        << perOperation(counts.values[PerfCounters::Instructions], totalOperations)
+        << ", \"ipc\": " << (ipc < 0 ? string("null") : to_string(ipc))
+        << ", \"llc_misses_per_op\": " 
+        << perOperation(counts.values[PerfCounters::CacheMisses], totalOperations)
+        << ", \"branch_misses_per_op\": " 
+        << perOperation(counts.values[PerfCounters::BranchMisses], totalOperations)
+        << "}";
+  }
+
+  out << "\n  ]\n}" << endl;
+}
+
+/**
+ * Quotes a string for JSON, escaping the characters that need it.
+ *
+ * @param text The string.
+ * @return The quoted string.
+ */
+string BenchmarkRunner::quote(const string &text) {
+  string quoted = "\"";
+
+  for(char c : text) {
+    if(c == '"' || c == '\\') {
+      quoted += '\\';
+      quoted += c;
+
+    } else if(static_cast<unsigned char>(c) < 0x20) {
+        char escaped[8];
+        snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        quoted += escaped;
+
+    } else {
+        quoted += c;
+    }
+  }
+
+  return quoted + "\"";
+}
+
+/**
+ * Formats a count divided by a number of operations for JSON.
+ *
+ * @param count The count, or -1 if it could not be read.
+ * @param operations The number of operations it covers.
+ * @return The count per operation, or null.
+ */
+string BenchmarkRunner::perOperation(long long count, long long operations) {
+  if(count < 0) {
+    return "null";
+  }
+
+  char text[32];
+  snprintf(text, sizeof(text), "%.4g", double(count) / max(1LL, operations));
+  return text;
+}
+
+/**
+ * Class Destructor
+ */
+BenchmarkRunner::~BenchmarkRunner() {}
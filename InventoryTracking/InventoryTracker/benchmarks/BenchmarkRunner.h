@@ -0,0 +1,75 @@
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+/**
+ * BenchmarkRunner - runs microbenchmarks and reports them as JSON.
+ *
+ * Each benchmark is a function that performs a known number of operations
+ * and marks the part worth timing with its Timer, so setting up data and
+ * tearing it down are left out. The runner calls it a number of times and
+ * keeps the fastest and median time per operation. When every benchmark has
+ * run, the results are written as one JSON document along with the context
+ * they were taken in, so runs can be compared across releases. Where the
+ * hardware counters can be read, each benchmark's timed sections are also
+ * counted, and instructions, IPC, last-level cache misses and branch 
+ * mispredictions per operation are reported alongside its times.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "../PerfCounters.h"
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+class BenchmarkRunner {
+public:
+  typedef vector<pair<string, string>> Parameters;
+
+  class Timer {
+  public:
+    Timer(const PerfCounters *counters = nullptr);
+    void start();
+    void stop();
+    double elapsedNanoseconds() const;
+    const PerfCounters::Reading &getCounts() const;
+
+  private:
+    const PerfCounters *counters;
+    chrono::steady_clock::time_point started;
+    double elapsed;
+    PerfCounters::Reading startedCounts;
+    PerfCounters::Reading counted;
+  };
+
+  struct Result {
+    string name;
+    Parameters parameters;
+    long long operations = 0;
+    int repeats = 0;
+    double bestNanoseconds = 0;     // per operation, over the repeats
+    double medianNanoseconds = 0;   // per operation, over the repeats
+    PerfCounters::Reading counts;   // over all the repeats
+  };
+
+  BenchmarkRunner(int repeats = 5, const string &filter = string());
+  void run(const string &, const Parameters &, long long, const function<void(Timer &)> &);
+  const vector<Result> &getResults() const;
+  void writeJson(ostream &) const;
+  ~BenchmarkRunner();
+
+private:
+  int repeats;
+  string filter;
+  PerfCounters counters;
+  vector<Result> results;
+
+  static string quote(const string &);
+  static string perOperation(long long, long long);
+};
+#endif // BENCHMARKRUNNER_H
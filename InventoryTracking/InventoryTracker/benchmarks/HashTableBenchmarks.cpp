@@ -0,0 +1,152 @@
+/**
+ * HashTableBenchmarks - microbenchmarks for inserting, finding and removing
+ * customers in the customer HashTable.
+ *
+ * The table has a fixed number of buckets, so its cost grows with the 
+ * number of customers it holds. Lookups and removals are run at several 
+ * sizes and at several hit rates, since a miss walks a whole bucket.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "HashTableBenchmarks.h"
+#include "../HashTable.h"
+#include <algorithm>
+#include <random>
+#include <sstream>
+using namespace std;
+
+namespace {
+  // Customer IDs start here, as in the store's customer files.
+  const int firstID = 1000;
+
+  /**
+   * Creates customers with consecutive IDs in an arena.
+   *
+   * @param arena The arena to create them in.
+   * @param size The number of customers.
+   * @return The customers, in a shuffled order.
+   */
+  vector<Customer*> makeCustomers(Arena &arena, int size) {
+    vector<Customer*> customers;
+
+    for(int i = 0; i < size; i++) {
+      customers.push_back(arena.create<Customer>(firstID + i, "First", "Last"));
+    }
+
+    shuffle(customers.begin(), customers.end(), mt19937(size));
+    return customers;
+  }
+
+  /**
+   * Picks the IDs to look up, of which the given share belong to a 
+   * customer in the table and the rest do not. No ID is picked twice, so 
+   * removing them hits at the same rate as finding them.
+   *
+   * @param size The number of customers in the table.
+   * @param hitRate The share of IDs that are found.
+   * @return The IDs, one per customer in the table.
+   */
+  vector<int> makeLookups(int size, double hitRate) {
+    vector<int> lookups(size);
+    mt19937 random(size + 1);
+
+    for(int i = 0; i < size; i++) {
+      lookups[i] = firstID + i + (i < hitRate * size ? 0 : size);
+    }
+
+    shuffle(lookups.begin(), lookups.end(), random);
+    return lookups;
+  }
+
+  /**
+   * Formats a hit rate for a benchmark parameter.
+   *
+   * @param hitRate The hit rate.
+   * @return The rate, such as "0.5".
+   */
+  string formatRate(double hitRate) {
+    ostringstream text;
+    text << hitRate;
+    return text.str();
+  }
+}
+
+/**
+ * Runs the HashTable benchmarks: inserting every customer, then finding 
+ * and removing customers at hit rates of 100%, 50% and 0%. The customers
+ * are kept in an arena, as the Store keeps them.
+ *
+ * @param runner The runner to run the benchmarks with.
+ */
+void HashTableBenchmarks::run(BenchmarkRunner &runner) {
+  const int sizes[] = {1000, 10000, 100000};
+  const double hitRates[] = {1.0, 0.5, 0.0};
+
+  for(int size : sizes) {
+    runner.run("HashTable/insert", {{"size", to_string(size)}}, size, 
+      [size](BenchmarkRunner::Timer &timer) {
+      Arena arena;
+      vector<Customer*> customers = makeCustomers(arena, size);
+      HashTable table(101, &arena);
+      timer.start();
+
+      for(Customer *customer : customers) {
+        table.insert(customer);
+      }
+
+      timer.stop();
+    });
+
+    for(double hitRate : hitRates) {
+      BenchmarkRunner::Parameters parameters = {
+        {"size", to_string(size)}, {"hit_rate", formatRate(hitRate)}
+      };
+
+      runner.run("HashTable/get", parameters, size, [size, hitRate](BenchmarkRunner::Timer &timer) {
+        Arena arena;
+        HashTable table(101, &arena);
+
+        for(Customer *customer : makeCustomers(arena, size)) {
+          table.insert(customer);
+        }
+
+        vector<int> lookups = makeLookups(size, hitRate);
+        long long expected = count_if(lookups.begin(), lookups.end(), 
+          [size](int id) { return id < firstID + size; });
+        long long found = 0;
+        timer.start();
+
+        for(int id : lookups) {
+          found += table.get(id) != nullptr;
+        }
+
+        timer.stop();
+
+        if(found != expected) {
+          cerr << "HashTable/get: found " << found << " customers, expected " 
+               << expected << "." << endl;
+        }
+      });
+
+      runner.run("HashTable/remove", parameters, size, [size, hitRate](BenchmarkRunner::Timer &timer) {
+        Arena arena;
+        HashTable table(101, &arena);
+
+        for(Customer *customer : makeCustomers(arena, size)) {
+          table.insert(customer);
+        }
+
+        vector<int> lookups = makeLookups(size, hitRate);
+        timer.start();
+
+        for(int id : lookups) {
+          table.remove(id);
+        }
+
+        timer.stop();
+      });
+    }
+  }
+}
@@ -0,0 +1,23 @@
+#ifndef HASHTABLEBENCHMARKS_H
+#define HASHTABLEBENCHMARKS_H
+
+/**
+ * HashTableBenchmarks - microbenchmarks for inserting, finding and removing
+ * customers in the customer HashTable.
+ *
+ * The table has a fixed number of buckets, so its cost grows with the 
+ * number of customers it holds. Lookups and removals are run at several 
+ * sizes and at several hit rates, since a miss walks a whole bucket.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "BenchmarkRunner.h"
+using namespace std;
+
+class HashTableBenchmarks {
+public:
+  static void run(BenchmarkRunner &);
+};
+#endif // HASHTABLEBENCHMARKS_H
@@ -0,0 +1,143 @@
+/**
+ * MovieTreeBenchmarks - microbenchmarks for inserting, retrieving and
+ * displaying movies in a MovieTree.
+ *
+ * The tree is not balanced, so the order movies are inserted in decides
+ * its shape: inserting them in sorted order builds a list, while a random
+ * order builds a tree of logarithmic depth. Each benchmark is run for both
+ * orders at several sizes.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "MovieTreeBenchmarks.h"
+#include "../MovieFactory.h"
+#include "../MovieTree.h"
+#include "../StringPool.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+using namespace std;
+
+namespace {
+  /**
+   * Comedies to insert, created in an arena with their names interned,
+   * in the order they are to be inserted.
+   */
+  struct Catalog {
+    Arena arena;
+    StringPool names;
+    vector<Movie*> movies;
+    vector<int> titles;     // the title handle of each movie
+
+    /**
+     * Creates the comedies. Their titles are numbered so that sorted 
+     * order is the order they were numbered in.
+     *
+     * @param size The number of comedies.
+     * @param sorted true to keep them in sorted order; false to shuffle them.
+     */
+    Catalog(int size, bool sorted) {
+      char title[64];
+
+      for(int i = 0; i < size; i++) {
+        snprintf(title, sizeof(title), "The Comedy of Errors Part %08d", i);
+        movies.push_back(MovieFactory::createMovie('F', "Director Name", title, "", 0, 
+          1990, names, &arena));
+        titles.push_back(names.find(title));
+      }
+
+      if(!sorted) {
+        mt19937 random(size);
+        for(int i = size - 1; i > 0; i--) {
+          int j = random() % (i + 1);
+          swap(movies[i], movies[j]);
+          swap(titles[i], titles[j]);
+        }
+      }
+    }
+  };
+}
+
+/**
+ * Runs the MovieTree benchmarks: inserting every movie of a catalog, 
+ * retrieving each of them by the fields a borrow command names, and 
+ * displaying the whole tree into a string. A tree built in sorted order 
+ * is as deep as it is large, so the sorted runs stop at smaller sizes.
+ *
+ * @param runner The runner to run the benchmarks with.
+ */
+void MovieTreeBenchmarks::run(BenchmarkRunner &runner) {
+  const int sizes[] = {1000, 10000, 100000};
+
+  for(bool sorted : {true, false}) {
+    for(int size : sizes) {
+      if(sorted && size > 10000) {
+        continue;
+      }
+
+      BenchmarkRunner::Parameters parameters = {
+        {"order", sorted ? "sorted" : "random"}, {"size", to_string(size)}
+      };
+
+      runner.run("MovieTree/insert", parameters, size, [size, sorted](BenchmarkRunner::Timer &timer) {
+        Catalog catalog(size, sorted);
+        MovieTree tree(&catalog.arena);
+        timer.start();
+
+        for(Movie *movie : catalog.movies) {
+          tree.insert(movie);
+        }
+
+        timer.stop();
+      });
+
+      runner.run("MovieTree/retrieve", parameters, size, [size, sorted](BenchmarkRunner::Timer &timer) {
+        Catalog catalog(size, sorted);
+        MovieTree tree(&catalog.arena);
+
+        for(Movie *movie : catalog.movies) {
+          tree.insert(movie);
+        }
+
+        // Look the movies up in an order unrelated to how they were inserted.
+        vector<int> lookups = catalog.titles;
+        shuffle(lookups.begin(), lookups.end(), mt19937(size + 1));
+        Movie *found = nullptr;
+        int hits = 0;
+        timer.start();
+
+        for(int title : lookups) {
+          hits += tree.retrieve(Comedy('F', -1, title, 1990, &catalog.names), found);
+        }
+
+        timer.stop();
+
+        if(hits != size) {
+          cerr << "MovieTree/retrieve: only " << hits << " of " << size << " found." << endl;
+        }
+      });
+
+      runner.run("MovieTree/display", parameters, size, [size, sorted](BenchmarkRunner::Timer &timer) {
+        Catalog catalog(size, sorted);
+        MovieTree tree(&catalog.arena);
+
+        for(Movie *movie : catalog.movies) {
+          tree.insert(movie);
+        }
+
+        string report;
+        ReportWriter::StringSink sink(report);
+        timer.start();
+
+        {
+          ReportWriter out(sink);
+          tree.display(out);
+        }
+
+        timer.stop();
+      });
+    }
+  }
+}
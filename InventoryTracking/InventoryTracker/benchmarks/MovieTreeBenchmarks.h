@@ -0,0 +1,24 @@
+#ifndef MOVIETREEBENCHMARKS_H
+#define MOVIETREEBENCHMARKS_H
+
+/**
+ * MovieTreeBenchmarks - microbenchmarks for inserting, retrieving and
+ * displaying movies in a MovieTree.
+ *
+ * The tree is not balanced, so the order movies are inserted in decides
+ * its shape: inserting them in sorted order builds a list, while a random
+ * order builds a tree of logarithmic depth. Each benchmark is run for both
+ * orders at several sizes.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "BenchmarkRunner.h"
+using namespace std;
+
+class MovieTreeBenchmarks {
+public:
+  static void run(BenchmarkRunner &);
+};
+#endif // MOVIETREEBENCHMARKS_H
@@ -0,0 +1,182 @@
+/**
+ * ParserBenchmarks - microbenchmarks for the Store's parsers of movie,
+ * customer and command lines.
+ *
+ * Each parser is timed on realistic lines of every kind it accepts. The
+ * lines are built before timing starts. Parsing a movie line also inserts
+ * the movie into its genre's tree, and parsing a command line interns its
+ * attributes, as they do when a file is loaded.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "ParserBenchmarks.h"
+#include "../Store.h"
+#include <cstdio>
+using namespace std;
+
+namespace {
+  const int lineCount = 100000;
+
+  // Distinct movies the command lines refer to, cycled through.
+  const int commandMovies = 1000;
+
+  /**
+   * Scrambles a line number so that movies numbered in order are not 
+   * inserted into their tree in sorted order. Distinct numbers stay 
+   * distinct.
+   *
+   * @param number The line number.
+   * @return The scrambled number.
+   */
+  unsigned scramble(unsigned number) {
+    return number * 2654435761u;
+  }
+
+  /**
+   * Builds movie lines of one genre, all distinct.
+   *
+   * @param genre 'C', 'D' or 'F'.
+   * @return The lines.
+   */
+  vector<string> movieLines(char genre) {
+    vector<string> lines;
+    char line[160];
+
+    for(int i = 0; i < lineCount; i++) {
+      unsigned key = scramble(i);
+
+      if(genre == 'C') {
+        snprintf(line, sizeof(line), "C, 10, Michael Curtiz, Casablanca %u, Ingrid Bergman%u %u %u",
+          key, key % 977, 1 + key % 12, 1920 + key % 60);
+
+      } else if(genre == 'D') {
+          snprintf(line, sizeof(line), "D, 10, Barry Levinson %u, Good Morning Vietnam %u, 1988",
+            key % 5000, key);
+
+      } else {
+          snprintf(line, sizeof(line), "F, 10, Nora Ephron, You've Got Mail %u, %u", 
+            key, 1950 + key % 60);
+      }
+
+      lines.push_back(line);
+    }
+
+    return lines;
+  }
+
+  /**
+   * Builds customer lines.
+   *
+   * @return The lines.
+   */
+  vector<string> customerLines() {
+    vector<string> lines;
+
+    for(int i = 0; i < lineCount; i++) {
+      lines.push_back(to_string(1000 + i) + " Witch Wicked");
+    }
+
+    return lines;
+  }
+
+  /**
+   * Builds command lines of one kind, for customers and movies that vary 
+   * from line to line.
+   *
+   * @param kind "B C", "B D" or "R F" for a borrow or return of a genre,
+   *             "H" for a history or "I" for an inventory.
+   * @return The lines.
+   */
+  vector<string> commandLines(const string &kind) {
+    vector<string> lines;
+    char line[160];
+
+    for(int i = 0; i < lineCount; i++) {
+      unsigned movie = scramble(i % commandMovies);
+      int customer = 1000 + i % 5000;
+
+      if(kind == "H") {
+        snprintf(line, sizeof(line), "H %d", customer);
+
+      } else if(kind == "I") {
+          snprintf(line, sizeof(line), "I");
+
+      } else if(kind[2] == 'C') {
+          snprintf(line, sizeof(line), "%c %d D C %u %u Ingrid Bergman%u", kind[0], customer,
+            1 + movie % 12, 1920 + movie % 60, movie % 977);
+
+      } else if(kind[2] == 'D') {
+          snprintf(line, sizeof(line), "%c %d D D Barry Levinson %u, Good Morning Vietnam %u,",
+            kind[0], customer, movie % 5000, movie);
+
+      } else {
+          snprintf(line, sizeof(line), "%c %d D F You've Got Mail %u, %u", kind[0], customer,
+            movie, 1950 + movie % 60);
+      }
+
+      lines.push_back(line);
+    }
+
+    return lines;
+  }
+}
+
+/**
+ * Runs the parser benchmarks: movie lines of each genre, customer lines,
+ * and command lines of each kind. Each run parses into a new Store.
+ *
+ * @param runner The runner to run the benchmarks with.
+ */
+void ParserBenchmarks::run(BenchmarkRunner &runner) {
+  for(char genre : {'C', 'D', 'F'}) {
+    vector<string> lines = movieLines(genre);
+
+    runner.run("Store/parseMovieData", {{"genre", string(1, genre)}}, lines.size(), 
+      [&lines](BenchmarkRunner::Timer &timer) {
+      Store store;
+      timer.start();
+
+      for(const string &line : lines) {
+        int stock = 0;
+        Movie *movie = store.parseMovieData(line, stock);
+        if(movie != nullptr) {
+          store.addMovie(movie, stock);
+        }
+      }
+
+      timer.stop();
+    });
+  }
+
+  vector<string> lines = customerLines();
+
+  runner.run("Store/parseCustomerData", {}, lines.size(), [&lines](BenchmarkRunner::Timer &timer) {
+    Store store;
+    timer.start();
+
+    for(const string &line : lines) {
+      store.parseCustomerData(line);
+    }
+
+    timer.stop();
+  });
+
+  for(const string kind : {"B C", "B D", "R F", "H", "I"}) {
+    vector<string> lines = commandLines(kind);
+
+    runner.run("Store/parseTransactionData", {{"command", kind}}, lines.size(), 
+      [&lines](BenchmarkRunner::Timer &timer) {
+      Store store;
+      Transaction transaction;
+      timer.start();
+
+      for(const string &line : lines) {
+        store.parseTransactionData(line, transaction);
+      }
+
+      timer.stop();
+    });
+  }
+}
@@ -0,0 +1,24 @@
+#ifndef PARSERBENCHMARKS_H
+#define PARSERBENCHMARKS_H
+
+/**
+ * ParserBenchmarks - microbenchmarks for the Store's parsers of movie,
+ * customer and command lines.
+ *
+ * Each parser is timed on realistic lines of every kind it accepts. The
+ * lines are built before timing starts. Parsing a movie line also inserts
+ * the movie into its genre's tree, and parsing a command line interns its
+ * attributes, as they do when a file is loaded.
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "BenchmarkRunner.h"
+using namespace std;
+
+class ParserBenchmarks {
+public:
+  static void run(BenchmarkRunner &);
+};
+#endif // PARSERBENCHMARKS_H
@@ -0,0 +1,75 @@
+/**
+ * benchmarks - microbenchmarks of the store's data structures and parsers.
+ *
+ * Times the MovieTree, the customer HashTable and the Store's parsers of
+ * movie, customer and command lines at several sizes and mixes, and writes
+ * the results as JSON so they can be kept and compared across releases.
+ * Where perf_event_open is allowed, hardware counts per operation are
+ * included. Progress is reported on standard error.
+ *
+ * Build: make -C benchmarks
+ * Usage: ./benchmarks/benchmarks [options]
+ *   --filter <text>  only run benchmarks whose name contains the text
+ *   --repeats <n>    times each benchmark is run (default 5)
+ *   --json <file>    file to write the results to (default standard output)
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include "BenchmarkRunner.h"
+#include "HashTableBenchmarks.h"
+#include "MovieTreeBenchmarks.h"
+#include "ParserBenchmarks.h"
+#include <cstdlib>
+#include <fstream>
+using namespace std;
+
+int main(int argc, char *argv[]) {
+  string filter, jsonFile;
+  int repeats = 5;
+
+  for(int i = 1; i < argc; i++) {
+    string name = argv[i];
+
+    if(i + 1 >= argc) {
+      cout << "Usage: " << argv[0] << " [--filter text] [--repeats n] [--json file]" << endl;
+      return 1;
+    }
+
+    string value = argv[++i];
+
+    if(name == "--filter") {
+      filter = value;
+
+    } else if(name == "--repeats") {
+        repeats = atoi(value.c_str());
+
+    } else if(name == "--json") {
+        jsonFile = value;
+
+    } else {
+        cout << "Usage: " << argv[0] << " [--filter text] [--repeats n] [--json file]" << endl;
+        return 1;
+    }
+  }
+
+  BenchmarkRunner runner(repeats, filter);
+  MovieTreeBenchmarks::run(runner);
+  HashTableBenchmarks::run(runner);
+  ParserBenchmarks::run(runner);
+
+  if(jsonFile.empty()) {
+    runner.writeJson(cout);
+    return 0;
+  }
+
+  ofstream output(jsonFile);
+  if(!output) {
+    cout << "Error: cannot write " << jsonFile << "." << endl;
+    return 1;
+  }
+
+  runner.writeJson(output);
+  return 0;
+}
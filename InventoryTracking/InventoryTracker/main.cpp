@@ -9,18 +9,491 @@
  */
 #include <iostream>
 #include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include "LineReader.h"
 #include "Store.h"
+#include "CommandServer.h"
 using namespace std;
 
 /**
- * Function for testing implementation operability.
+ * Follows a growing transaction file instead of processing a fixed one.
+ * Usage: ./a.out --follow [transaction file] [idle timeout in ms]
+ *
+ * @param store The Store to load and execute commands against.
+ * @param movieFile The file containing movie data.
+ * @param customerFile The file containing customer data.
+ * @param transactionFile The transaction file to follow.
+ * @param idleTimeout Milliseconds without new commands before stopping, 
+ *                    or 0 to follow indefinitely.
+ * @return The process exit status.
  */
-int main() {
-  Store store;
+int followMode(Store &store, const string &movieFile, const string &customerFile,
+  const string &transactionFile, int idleTimeout) {
+  if(!store.loadCatalog(movieFile, customerFile)) {
+    cout << "Error loading data from files." << endl;
+    return 1;
+  }
+
+  cout << "Following " << transactionFile << "." << endl;
+  return store.followTransactions(transactionFile, idleTimeout) ? 0 : 1;
+}
+
+/**
+ * Loads the movies and customers, then serves commands to clients over a 
+ * socket until interrupted.
+ * Usage: ./a.out --serve <socket path or [host:]port>
+ *
+ * @param store The Store to load and serve.
+ * @param movieFile The file containing movie data.
+ * @param customerFile The file containing customer data.
+ * @param address The Unix socket path or TCP [host:]port to listen on.
+ * @return The process exit status.
+ */
+int serveMode(Store &store, const string &movieFile, const string &customerFile,
+  const string &address) {
+  if(!store.loadCatalog(movieFile, customerFile)) {
+    cout << "Error loading data from files." << endl;
+    return 1;
+  }
+
+  CommandServer server(store);
+  if(!server.listen(address)) {
+    return 1;
+  }
+
+  cout << "Listening on " << address << "." << endl;
+  return server.run() ? 0 : 1;
+}
+
+/**
+ * Loads the movies and customers, then times printing the full inventory 
+ * report: the first report, which renders every movie, and the following 
+ * ones, served from the cached reports. The report goes to standard output, which should be redirected 
+ * to a file or /dev/null; the timing is printed to standard error.
+ * Usage: ./a.out --bench-inventory <movie file> [repeats] > /dev/null
+ *
+ * @param store The Store to load.
+ * @param movieFile The file containing movie data.
+ * @param customerFile The file containing customer data.
+ * @param repeats The number of times to print the report.
+ * @return The process exit status.
+ */
+int benchInventoryMode(Store &store, const string &movieFile, const string &customerFile,
+  int repeats) {
+  if(!store.loadCatalog(movieFile, customerFile)) {
+    cout << "Error loading data from files." << endl;
+    return 1;
+  }
+
+  repeats = max(repeats, 2);
+  auto start = chrono::steady_clock::now();
+  store.executeCommand("I");
+  auto rendered = chrono::steady_clock::now();
+
+  for(int i = 1; i < repeats; i++) {
+    store.executeCommand("I");
+  }
+
+  double first = chrono::duration<double, milli>(rendered - start).count();
+  double rest = chrono::duration<double, milli>(chrono::steady_clock::now() - rendered).count();
+  cerr << "Printed the inventory " << repeats << " times: first report " << first 
+       << " ms, then " << rest / (repeats - 1) << " ms per report." << endl;
+  return 0;
+}
+
+/**
+ * Compares loading compressed data files directly, with streaming 
+ * decompression, against first decompressing them to disk and then 
+ * loading the decompressed copies. Reports the wall-clock time of each.
+ * Usage: ./a.out --compare-load <movie file> <customer file> <transaction file>
+ *
+ * @param movieFile The (possibly compressed) file containing movie data.
+ * @param customerFile The (possibly compressed) file containing customer data.
+ * @param transactionFile The (possibly compressed) file containing transaction data.
+ * @return The process exit status.
+ */
+int compareLoadMode(const string &movieFile, const string &customerFile,
+  const string &transactionFile) {
+  auto start = chrono::steady_clock::now();
+  {
+    Store store;
+    if(!store.loadData(movieFile, customerFile, transactionFile)) {
+      cout << "Error loading data from files." << endl;
+      return 1;
+    }
+  }
+  double streaming = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+  string files[] = {movieFile, customerFile, transactionFile};
+  string decompressed[] = {movieFile, customerFile, transactionFile};
+  bool succeeded = true;
+  start = chrono::steady_clock::now();
+
+  for(int i = 0; i < 3 && succeeded; i++) {
+    if(LineReader::isCompressedFile(files[i])) {
+      decompressed[i] = files[i] + ".decompressed";
+      if(!LineReader::decompressFile(files[i], decompressed[i])) {
+        cout << "Error decompressing " << files[i] << "." << endl;
+        succeeded = false;
+      }
+    }
+  }
+
+  double decompression = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+  if(succeeded) {
+    Store store;
+    if(!store.loadData(decompressed[0], decompressed[1], decompressed[2])) {
+      cout << "Error loading data from decompressed files." << endl;
+      succeeded = false;
+    }
+  }
+
+  double total = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+  for(int i = 0; i < 3; i++) {
+    if(decompressed[i] != files[i]) {
+      remove(decompressed[i].c_str());
+    }
+  }
+
+  if(!succeeded) {
+    return 1;
+  }
+
+  cout << "Streaming load: " << streaming << " ms" << endl;
+  cout << "Decompress-then-load: " << total << " ms (decompression " 
+       << decompression << " ms)" << endl;
+  return 0;
+}
+
+/**
+ * Compares the time to load the movies and customers, and to destroy the 
+ * loaded Store, with its entities in the Store's arenas and with each one 
+ * allocated on the heap.
+ * Usage: ./a.out --compare-arena <movie file> <customer file>
+ *
+ * @param movieFile The file containing movie data.
+ * @param customerFile The file containing customer data.
+ * @return The process exit status.
+ */
+int compareArenaMode(const string &movieFile, const string &customerFile) {
+  const char *allocators[] = {"Heap", "Arena"};
+
+  for(int i = 0; i < 2; i++) {
+    Store *store = new Store(i == 1);
+    auto start = chrono::steady_clock::now();
+
+    if(!store->loadCatalog(movieFile, customerFile)) {
+      cout << "Error loading data from files." << endl;
+      delete store;
+      return 1;
+    }
+
+    auto loaded = chrono::steady_clock::now();
+    delete store;
+    auto destroyed = chrono::steady_clock::now();
+
+    cout << allocators[i] << ": load " 
+         << chrono::duration<double, milli>(loaded - start).count() << " ms, teardown " 
+         << chrono::duration<double, milli>(destroyed - loaded).count() << " ms" << endl;
+  }
+
+  return 0;
+}
+
+/**
+ * Runs the named transaction engine on a Store.
+ *
+ * @param store The loaded Store whose transactions should be processed.
+ * @param engine "sequential", "genre", "waves" or "coalesced".
+ * @return false if the engine name is unknown; true otherwise.
+ */
+bool runEngine(Store &store, const string &engine) {
+  if(engine == "sequential") {
+    store.processTransactions();
+
+  } else if(engine == "genre") {
+      store.processTransactionsByGenre();
+
+  } else if(engine == "waves") {
+      store.processTransactionsInWaves();
+
+  } else if(engine == "coalesced") {
+      store.processTransactionsCoalesced();
+
+  } else {
+      cout << "Error: unknown engine " << engine << "." << endl;
+      return false;
+  }
 
+  return true;
+}
+
+/**
+ * Checks a transaction engine against sequential processing. Two Stores are
+ * loaded from the same files; one processes its transactions sequentially 
+ * and the other with the given engine, each with its output and logged 
+ * errors captured. The outputs are compared byte for byte and the 
+ * processing times reported.
+ * Usage: ./a.out --compare-engines <engine> <movie file> <customer file> <transaction file>
+ *
+ * @param engine The engine to check.
+ * @param movieFile The file containing movie data.
+ * @param customerFile The file containing customer data.
+ * @param transactionFile The file containing transaction data.
+ * @return The process exit status: 0 if the outputs match.
+ */
+int compareEnginesMode(const string &engine, const string &movieFile,
+  const string &customerFile, const string &transactionFile) {
+  string engines[] = {"sequential", engine};
+  string outputs[2];
+  double times[2];
+  Store::ExecutionStats stats[2];
+  ThreadPool::Stats runtimeStats[2];
+
+  for(int i = 0; i < 2; i++) {
+    Store store;
+    if(!store.loadData(movieFile, customerFile, transactionFile)) {
+      cout << "Error loading data from files." << endl;
+      return 1;
+    }
+
+    ostringstream captured;
+    streambuf *original = cout.rdbuf(captured.rdbuf());
+    Log::Capture errors(captured);
+    store.getRuntime().resetStats();
+    auto start = chrono::steady_clock::now();
+    bool known = runEngine(store, engines[i]);
+    times[i] = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout.rdbuf(original);
+    outputs[i] = captured.str();
+    stats[i] = store.getExecutionStats();
+    runtimeStats[i] = store.getRuntime().getStats();
+
+    if(!known) {
+      cout << outputs[i];
+      return 1;
+    }
+  }
+
+  bool match = outputs[0] == outputs[1];
+  for(int i = 0; i < 2; i++) {
+    cout << engines[i] << ": " << times[i] << " ms, " << stats[i].movieLookups 
+         << " movie lookups, " << stats[i].stockUpdates << " stock updates" << endl;
+    cout << "  thread pool: " << runtimeStats[i].threads << " threads, " 
+         << runtimeStats[i].tasksExecuted << " tasks, " << runtimeStats[i].steals 
+         << " steals, " << runtimeStats[i].utilization() * 100 << "% utilization" << endl;
+  }
+
+  cout << "Speedup: " << times[0] / times[1] << "x" << endl;
+  cout << "Outputs " << (match ? "match" : "differ") << " (" << outputs[0].size() 
+       << " bytes)." << endl;
+  return match ? 0 : 1;
+}
+
+/**
+ * Prints a table of the commands run, commands per second and latency 
+ * percentiles for each transaction type, followed by all types together.
+ * Commands per second count only the time spent executing commands.
+ *
+ * @param latencies The latency histograms by transaction type.
+ */
+void printLatencies(const map<char, LatencyHistogram> &latencies) {
+  LatencyHistogram all;
+  for(const auto &type : latencies) {
+    all.merge(type.second);
+  }
+
+  cout << "  type  commands  commands/s    p50 ns    p99 ns   p999 ns    max ns" << endl;
+
+  auto printRow = [](const string &type, const LatencyHistogram &latency) {
+    cout << "  " << left << setw(4) << type << right << setw(10) << latency.count() 
+         << setw(12) << (long long)(latency.count() * 1e9 / max(latency.total(), 1LL)) 
+         << setw(10) << latency.percentile(50) << setw(10) << latency.percentile(99) 
+         << setw(10) << latency.percentile(99.9) << setw(10) << latency.max() << endl;
+  };
+
+  for(const auto &type : latencies) {
+    printRow(string(1, type.first), type.second);
+  }
+
+  printRow("all", all);
+}
+
+/**
+ * Times the whole Store on a set of data files: loading each file, then 
+ * processing every command sequentially with its latency recorded by 
+ * transaction type. This is done with the output discarded, by putting 
+ * standard output in a failed state so nothing is formatted and only the 
+ * logic is timed, and with the output captured in memory, so the 
+ * difference is the cost of printing the results. The Store's output and 
+ * the messages logged on this thread go to neither; the report is printed
+ * to standard output at the end. Each is run a number of times, loading a
+ * new Store each time, and the run with the fastest processing is shown.
+ * Usage: ./a.out --bench-e2e <movie file> <customer file> <transaction file> [repeats]
+ *
+ * @param movieFile The file containing movie data.
+ * @param customerFile The file containing customer data.
+ * @param transactionFile The file containing transaction data.
+ * @param repeats The number of times to run with each kind of output.
+ * @return The process exit status.
+ */
+int benchEndToEndMode(const string &movieFile, const string &customerFile,
+  const string &transactionFile, int repeats) {
+  struct Run {
+    Store::LoadStats load;
+    map<char, LatencyHistogram> latencies;
+    double milliseconds = -1;
+    size_t outputBytes = 0;
+  };
+
+  const char *modes[] = {"discarded", "captured"};
+  Run fastest[2];
+
+  for(int repeat = 0; repeat < max(repeats, 1); repeat++) {
+    for(int i = 0; i < 2; i++) {
+      Store store;
+      Run run;
+      ostringstream captured;
+      streambuf *original = cout.rdbuf(captured.rdbuf());
+      if(i == 0) {
+        cout.setstate(ios::badbit);
+      }
+
+      bool loaded;
+      {
+        Log::Capture errors(cout);
+        loaded = store.loadData(movieFile, customerFile, transactionFile);
+        captured.str("");
+
+        auto start = chrono::steady_clock::now();
+        if(loaded) {
+          store.processTransactions(run.latencies);
+        }
+        run.milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+      }
+
+      cout.clear();
+      cout.rdbuf(original);
+
+      if(!loaded) {
+        cout << "Error loading data from files." << endl;
+        return 1;
+      }
+
+      run.load = store.getLoadStats();
+      run.outputBytes = captured.str().size();
+
+      if(fastest[i].milliseconds < 0 || run.milliseconds < fastest[i].milliseconds) {
+        fastest[i] = move(run);
+      }
+    }
+  }
+
+  for(int i = 0; i < 2; i++) {
+    const Run &run = fastest[i];
+    long long commands = 0;
+    for(const auto &type : run.latencies) {
+      commands += type.second.count();
+    }
+
+    cout << "Output " << modes[i];
+    if(i == 1) {
+      cout << " (" << run.outputBytes << " bytes)";
+    }
+
+    cout << ": " << commands << " commands in " << run.milliseconds << " ms, " 
+         << (long long)(commands * 1000 / max(run.milliseconds, 1e-3)) << " commands/s" << endl;
+    cout << "  load: movies " << run.load.movieMilliseconds << " ms, customers " 
+         << run.load.customerMilliseconds << " ms (alongside the movies), commands " 
+         << run.load.transactionMilliseconds << " ms" << endl;
+    printLatencies(run.latencies);
+  }
+
+  double printing = fastest[1].milliseconds - fastest[0].milliseconds;
+  cout << "Printing cost: " << printing << " ms, " 
+       << printing * 100 / max(fastest[1].milliseconds, 1e-3) 
+       << "% of processing with the output captured" << endl;
+  return 0;
+}
+
+/**
+ * Function for testing implementation operability.
+ */
+int main(int argc, char *argv[]) {
   string movieFile = "data4movies.txt";
   string customerFile = "data4customers.txt";
   string transactionFile = "data4commands.txt";
+  string traceFile;
+  bool countPhases = false;
+
+  // Logging, tracing and counter options may come before any of the modes below.
+  while(argc > 1 && (string(argv[1]) == "--perf" || (argc > 2 && (string(argv[1]) == "--log-level"
+    || string(argv[1]) == "--log-rate" || string(argv[1]) == "--trace")))) {
+    if(string(argv[1]) == "--perf") {
+      countPhases = true;
+      argc--;
+      argv++;
+      continue;
+    }
+
+    if(string(argv[1]) == "--log-rate") {
+      Log::setRateLimit(atoi(argv[2]));
+
+    } else if(string(argv[1]) == "--trace") {
+        traceFile = argv[2];
+
+    } else if(!Log::setLevel(argv[2])) {
+        cout << "Error: unknown log level " << argv[2] << "." << endl;
+        return 1;
+    }
+
+    argc -= 2;
+    argv += 2;
+  }
+
+  // Records spans and counts phases from here on, and saves the trace and
+  // prints the counts when main returns.
+  Trace::Recording tracing(traceFile);
+  PerfCounters::Recording counting(countPhases, cerr);
+
+  if(argc > 4 && string(argv[1]) == "--compare-load") {
+    return compareLoadMode(argv[2], argv[3], argv[4]);
+  }
+
+  if(argc > 3 && string(argv[1]) == "--compare-arena") {
+    return compareArenaMode(argv[2], argv[3]);
+  }
+
+  if(argc > 4 && string(argv[1]) == "--bench-e2e") {
+    return benchEndToEndMode(argv[2], argv[3], argv[4], argc > 5 ? atoi(argv[5]) : 3);
+  }
+
+  if(argc > 5 && string(argv[1]) == "--compare-engines") {
+    return compareEnginesMode(argv[2], argv[3], argv[4], argv[5]);
+  }
+
+  // The modes above build their own Stores; the rest share this one.
+  Store store;
+
+  if(argc > 1 && string(argv[1]) == "--follow") {
+    return followMode(store, movieFile, customerFile, 
+      argc > 2 ? argv[2] : transactionFile, argc > 3 ? atoi(argv[3]) : 0);
+  }
+
+  if(argc > 2 && string(argv[1]) == "--serve") {
+    return serveMode(store, movieFile, customerFile, argv[2]);
+  }
+
+  if(argc > 2 && string(argv[1]) == "--bench-inventory") {
+    return benchInventoryMode(store, argv[2], customerFile, argc > 3 ? atoi(argv[3]) : 1);
+  }
 
   // Load data from files
   if(!store.loadData(movieFile, customerFile, transactionFile)) {
@@ -30,6 +503,7 @@ int main() {
 
   cout << "Data loaded successfully." << endl;
   store.processTransactions();
+  Log::flush();
   cout << "Transactions processed." << endl;
   cout << "Cleanup completed." << endl;
 
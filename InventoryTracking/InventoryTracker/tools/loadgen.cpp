@@ -0,0 +1,312 @@
+/**
+ * loadgen - a load generator for the store's command server.
+ *
+ * Opens many concurrent connections to a server started with `--serve` and
+ * sends commands read from a command file (one line per command, reused 
+ * in turn). Each connection pipelines its requests: it keeps up to the 
+ * pipeline depth of commands outstanding, sending the next one whenever 
+ * a reply, which ends with a line containing only ".", arrives. All 
+ * connections are driven by one thread through epoll. When every 
+ * connection has received its replies, the throughput and the latency 
+ * distribution of the requests are reported.
+ *
+ * Build: g++ -O2 tools/loadgen.cpp -o loadgen
+ * Usage: ./loadgen <socket path or [host:]port> <command file> 
+ *                  [connections] [requests per connection] [pipeline depth]
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+using namespace std;
+
+struct Connection {
+  int descriptor = -1;
+  size_t nextCommand = 0;                   // index of the next command to send
+  long long sent = 0;                       // requests sent so far
+  long long completed = 0;                  // replies received so far
+  string input;                             // reply bytes not yet consumed
+  string output;                            // request bytes not yet sent
+  deque<chrono::steady_clock::time_point> sentAt;  // send times of outstanding requests
+};
+
+/**
+ * Connects to the server, using a Unix domain socket for addresses 
+ * containing a '/' and TCP otherwise, as the server does.
+ *
+ * @param address The socket path or [host:]port of the server.
+ * @return The connected, non-blocking socket, or -1 on failure.
+ */
+int connectTo(const string &address) {
+  int descriptor = -1;
+  bool connected = false;
+
+  if(address.find('/') != string::npos) {
+    sockaddr_un remote = {};
+    remote.sun_family = AF_UNIX;
+    strncpy(remote.sun_path, address.c_str(), sizeof(remote.sun_path) - 1);
+    descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    connected = descriptor >= 0 
+      && connect(descriptor, reinterpret_cast<sockaddr*>(&remote), sizeof(remote)) == 0;
+
+  } else {
+      size_t colon = address.rfind(':');
+      string host = colon == string::npos ? "127.0.0.1" : address.substr(0, colon);
+      string port = colon == string::npos ? address : address.substr(colon + 1);
+      sockaddr_in remote = {};
+      remote.sin_family = AF_INET;
+      remote.sin_port = htons(static_cast<uint16_t>(atoi(port.c_str())));
+      descriptor = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      int noDelay = 1;
+      connected = descriptor >= 0
+        && inet_pton(AF_INET, host.c_str(), &remote.sin_addr) == 1
+        && setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)) == 0
+        && connect(descriptor, reinterpret_cast<sockaddr*>(&remote), sizeof(remote)) == 0;
+  }
+
+  if(!connected || fcntl(descriptor, F_SETFL, O_NONBLOCK) != 0) {
+    if(descriptor >= 0) {
+      close(descriptor);
+    }
+
+    return -1;
+  }
+
+  return descriptor;
+}
+
+/**
+ * Queues a connection's next command to be sent by `flush`.
+ *
+ * @param connection The connection to send on.
+ * @param commands The commands to send, used in turn.
+ */
+void sendRequest(Connection &connection, const vector<string> &commands) {
+  connection.output += commands[connection.nextCommand];
+  connection.output += '\n';
+  connection.nextCommand = (connection.nextCommand + 1) % commands.size();
+  connection.sent++;
+  connection.sentAt.push_back(chrono::steady_clock::now());
+}
+
+/**
+ * Sends as much of a connection's queued requests as the socket accepts.
+ *
+ * @param connection The connection to send on.
+ * @return false if the connection failed; true otherwise.
+ */
+bool flush(Connection &connection) {
+  while(!connection.output.empty()) {
+    ssize_t written = send(connection.descriptor, connection.output.data(), 
+      connection.output.size(), MSG_NOSIGNAL);
+
+    if(written >= 0) {
+      connection.output.erase(0, written);
+
+    } else if(errno == EAGAIN || errno == EWOULDBLOCK) {
+        return true;
+
+    } else if(errno != EINTR) {
+        return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Reads a connection's replies and records the latency of each completed 
+ * one, sending the next request until the connection has made all of them.
+ *
+ * @param connection The connection to read from.
+ * @param commands The commands to send, used in turn.
+ * @param requests The number of requests each connection makes.
+ * @param latencies Receives the latency of each reply in microseconds.
+ * @return false if the connection failed or closed early; true otherwise.
+ */
+bool readReplies(Connection &connection, const vector<string> &commands, 
+  long long requests, vector<double> &latencies) {
+  char buffer[65536];
+
+  while(true) {
+    ssize_t received = recv(connection.descriptor, buffer, sizeof(buffer), 0);
+
+    if(received > 0) {
+      connection.input.append(buffer, received);
+      continue;
+    }
+
+    if(received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+      return false;
+    }
+
+    if(errno != EINTR) {
+      break;
+    }
+  }
+
+  size_t lineStart = 0, lineEnd;
+
+  while((lineEnd = connection.input.find('\n', lineStart)) != string::npos) {
+    bool endOfReply = lineEnd - lineStart == 1 && connection.input[lineStart] == '.';
+    lineStart = lineEnd + 1;
+
+    if(!endOfReply) {
+      continue;
+    }
+
+    latencies.push_back(chrono::duration<double, micro>(
+      chrono::steady_clock::now() - connection.sentAt.front()).count());
+    connection.sentAt.pop_front();
+    connection.completed++;
+
+    if(connection.sent < requests) {
+      sendRequest(connection, commands);
+    }
+  }
+
+  connection.input.erase(0, lineStart);
+  return true;
+}
+
+/**
+ * Returns the value at the given percentile of sorted values.
+ *
+ * @param sorted The values, in ascending order.
+ * @param percentile The percentile, between 0 and 100.
+ * @return The value at that percentile, or 0 if there are no values.
+ */
+double percentile(const vector<double> &sorted, double percentile) {
+  if(sorted.empty()) {
+    return 0.0;
+  }
+
+  size_t index = static_cast<size_t>(percentile / 100.0 * (sorted.size() - 1) + 0.5);
+  return sorted[min(index, sorted.size() - 1)];
+}
+
+int main(int argc, char *argv[]) {
+  if(argc < 3) {
+    cout << "Usage: " << argv[0] << " <socket path or [host:]port> <command file> "
+         << "[connections] [requests per connection] [pipeline depth]" << endl;
+    return 1;
+  }
+
+  string address = argv[1];
+  int connectionCount = argc > 3 ? atoi(argv[3]) : 100;
+  long long requests = argc > 4 ? atoll(argv[4]) : 1000;
+  long long depth = argc > 5 ? atoll(argv[5]) : 1;
+
+  ifstream commandFile(argv[2]);
+  vector<string> commands;
+  string line;
+
+  while(getline(commandFile, line)) {
+    if(!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+
+    if(!line.empty()) {
+      commands.push_back(line);
+    }
+  }
+
+  if(commands.empty() || connectionCount <= 0 || requests <= 0 || depth <= 0) {
+    cout << "Error: no commands in " << argv[2] << ", or no connections, requests or depth." << endl;
+    return 1;
+  }
+
+  rlimit limit;
+  if(getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+
+  int epollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+  vector<Connection> connections(connectionCount);
+
+  for(int i = 0; i < connectionCount; i++) {
+    connections[i].descriptor = connectTo(address);
+
+    if(connections[i].descriptor < 0) {
+      cout << "Error: cannot connect to " << address << ": " << strerror(errno) << "." << endl;
+      return 1;
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+    event.data.u32 = i;
+    epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, connections[i].descriptor, &event);
+    // Spread the connections over the command file.
+    connections[i].nextCommand = static_cast<size_t>(i) * 7919 % commands.size();
+  }
+
+  vector<double> latencies;
+  latencies.reserve(static_cast<size_t>(connectionCount) * requests);
+  auto start = chrono::steady_clock::now();
+
+  for(Connection &connection : connections) {
+    while(connection.sent < min(depth, requests)) {
+      sendRequest(connection, commands);
+    }
+
+    flush(connection);
+  }
+
+  int active = connectionCount, failures = 0;
+  epoll_event events[256];
+
+  while(active > 0) {
+    int ready = epoll_wait(epollDescriptor, events, 256, -1);
+
+    for(int i = 0; i < ready; i++) {
+      Connection &connection = connections[events[i].data.u32];
+
+      if(connection.descriptor < 0) {
+        continue;
+      }
+
+      bool open = readReplies(connection, commands, requests, latencies) && flush(connection);
+
+      if(!open || connection.completed == requests) {
+        failures += !open;
+        close(connection.descriptor);
+        connection.descriptor = -1;
+        active--;
+      }
+    }
+  }
+
+  double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  sort(latencies.begin(), latencies.end());
+
+  cout << "Connections: " << connectionCount << " (" << failures << " failed), pipeline depth: " 
+       << depth << ", requests: " << latencies.size() << endl;
+  cout << "Elapsed: " << elapsed << " s, throughput: " << latencies.size() / elapsed 
+       << " requests/s" << endl;
+  cout << "Latency (us): p50 " << percentile(latencies, 50) << ", p99 " 
+       << percentile(latencies, 99) << ", p99.9 " << percentile(latencies, 99.9) 
+       << ", max " << (latencies.empty() ? 0.0 : latencies.back()) << endl;
+
+  close(epollDescriptor);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,477 @@
+/**
+ * workloadgen - a generator of large, reproducible store workloads.
+ *
+ * Writes a movie file, a customer file and a command file in exactly the
+ * formats the store reads, named data4movies.txt, data4customers.txt and
+ * data4commands.txt so the store can be run on them from their directory.
+ *
+ * Titles, directors and actors are made up from generated words. Each
+ * classic is released in one to three editions that share a title and
+ * director but star different actors, as in the store's own data. Movies
+ * are borrowed and returned with Zipfian popularity: the movie of rank r
+ * is picked with a probability proportional to 1 / r^s, with the ranks
+ * shuffled across the genres. A share of the commands can name customers
+ * that do not exist or genres the store does not know, and a share of the
+ * movie lines can have an unknown genre, to exercise the error paths.
+ * The same options and seed always produce the same files.
+ *
+ * Build: g++ -O2 tools/workloadgen.cpp -o workloadgen
+ * Usage: ./workloadgen <output directory> [options]
+ *   --movies <n>               movies to generate (default 100000)
+ *   --customers <n>            customers to generate (default 10000)
+ *   --commands <n>             commands to generate (default 1000000)
+ *   --genres <C:D:F>           relative shares of classics, dramas and
+ *                              comedies (default 1:1:1)
+ *   --zipf <s>                 popularity exponent; 0 is uniform (default 1)
+ *   --invalid-customer <rate>  share of commands naming no customer (default 0.01)
+ *   --invalid-genre <rate>     share of commands and movie lines with an
+ *                              unknown genre (default 0.001)
+ *   --history <rate>           share of commands that are histories (default 0.01)
+ *   --inventory <rate>         share of commands that are inventories (default 0)
+ *   --returns <rate>           share of borrows and returns that are returns
+ *                              (default 0.5)
+ *   --stock <n>                copies of each movie in stock (default 10)
+ *   --seed <n>                 random seed (default 1)
+ *
+ * Nolan Dela Rosa
+ *
+ * October 19, 2026
+ */
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+struct Options {
+  long long movies = 100000;
+  long long customers = 10000;
+  long long commands = 1000000;
+  double genreShares[3] = {1, 1, 1};      // classics, dramas, comedies
+  double zipf = 1.0;
+  double invalidCustomer = 0.01;
+  double invalidGenre = 0.001;
+  double history = 0.01;
+  double inventory = 0.0;
+  double returns = 0.5;
+  int stock = 10;
+  unsigned long long seed = 1;
+};
+
+struct Movie {
+  char genre;
+  string director;
+  string title;
+  string actor;       // classics only
+  int month;          // classics only
+  int year;
+};
+
+/**
+ * Draws random numbers. Only the engine's raw output is used, which the
+ * standard fixes, so the files do not depend on the standard library.
+ */
+class Random {
+public:
+  Random(unsigned long long seed) : engine(seed) {}
+
+  /**
+   * Returns a random integer below a bound.
+   *
+   * @param bound The bound; must be positive.
+   * @return An integer from 0 to bound - 1.
+   */
+  unsigned long long below(unsigned long long bound) {
+    return engine() % bound;
+  }
+
+  /**
+   * Returns a random number in [0, 1).
+   *
+   * @return The number.
+   */
+  double unit() {
+    return (engine() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+private:
+  mt19937_64 engine;
+};
+
+/**
+ * Makes up a capitalized word of one to three syllables.
+ *
+ * @param random The random numbers to use.
+ * @return The word.
+ */
+string makeWord(Random &random) {
+  static const char *syllables[] = {
+    "ka", "lo", "mi", "ra", "ven", "dor", "sil", "tan", "bel", "mor",
+    "ish", "ute", "ar", "en", "ol", "qui", "zan", "ter", "pha", "gri",
+    "no", "sa", "ri", "van", "del", "cor", "ma", "lin", "est", "ho"
+  };
+  const int syllableCount = sizeof(syllables) / sizeof(syllables[0]);
+  string word;
+
+  for(int i = 1 + random.below(3); i > 0; i--) {
+    word += syllables[random.below(syllableCount)];
+  }
+
+  word[0] = toupper(word[0]);
+  return word;
+}
+
+/**
+ * Makes up a list of distinct "First Last" names.
+ *
+ * @param random The random numbers to use.
+ * @param firstNames The first names to choose from.
+ * @param lastNames The last names to choose from.
+ * @param count The number of names wanted, at most half of the possible 
+ *              combinations.
+ * @return The names.
+ */
+vector<string> makeNames(Random &random, const vector<string> &firstNames,
+  const vector<string> &lastNames, size_t count) {
+  count = min(count, firstNames.size() * lastNames.size() / 2);
+  unordered_set<string> seen;
+  vector<string> names;
+
+  while(names.size() < count) {
+    string name = firstNames[random.below(firstNames.size())] + " "
+      + lastNames[random.below(lastNames.size())];
+
+    if(seen.insert(name).second) {
+      names.push_back(name);
+    }
+  }
+
+  return names;
+}
+
+/**
+ * Makes up the movies. Each genre's movies are distinct by the fields the
+ * store sorts and looks them up by, so none is dropped as a duplicate:
+ * release date and actor for classics, director and title for dramas,
+ * title and year for comedies.
+ *
+ * @param random The random numbers to use.
+ * @param options The generator's options.
+ * @return The movies, in the order they are written.
+ */
+vector<Movie> makeMovies(Random &random, const Options &options) {
+  vector<string> words;
+  for(int i = 0; i < 5000; i++) {
+    words.push_back(makeWord(random));
+  }
+
+  const char *common[] = {"The", "Of", "A", "In", "And", "Night", "Love", "Last", "Day", "Return"};
+  words.insert(words.end(), begin(common), end(common));
+
+  vector<string> firstNames(words.begin(), words.begin() + 800);
+  vector<string> lastNames(words.begin() + 800, words.begin() + 2800);
+  vector<string> directors = makeNames(random, firstNames, lastNames,
+    max(1LL, options.movies / 8));
+  vector<string> actors = makeNames(random, firstNames, lastNames,
+    max(100LL, options.movies / 20));
+
+  double shareTotal = options.genreShares[0] + options.genreShares[1] + options.genreShares[2];
+  set<tuple<int, int, string>> classicKeys;
+  unordered_set<string> dramaKeys, comedyKeys;
+  vector<Movie> movies;
+
+  while(static_cast<long long>(movies.size()) < options.movies) {
+    string title;
+    for(int i = 1 + random.below(4); i > 0; i--) {
+      title += (title.empty() ? "" : " ") + words[random.below(words.size())];
+    }
+
+    Movie movie = {'C', directors[random.below(directors.size())], title, "",
+      static_cast<int>(1 + random.below(12)), static_cast<int>(1920 + random.below(101))};
+    double pick = random.unit() * shareTotal;
+
+    if(pick < options.genreShares[0]) {
+      for(int editions = 1 + random.below(3); editions > 0
+        && static_cast<long long>(movies.size()) < options.movies; editions--) {
+        movie.actor = actors[random.below(actors.size())];
+
+        if(classicKeys.emplace(movie.month, movie.year, movie.actor).second) {
+          movies.push_back(movie);
+        }
+      }
+
+    } else if(pick < options.genreShares[0] + options.genreShares[1]) {
+        movie.genre = 'D';
+        if(dramaKeys.insert(movie.director + "," + movie.title).second) {
+          movies.push_back(movie);
+        }
+
+    } else {
+        movie.genre = 'F';
+        if(comedyKeys.insert(movie.title + "," + to_string(movie.year)).second) {
+          movies.push_back(movie);
+        }
+    }
+  }
+
+  return movies;
+}
+
+/**
+ * Writes a movie's line of the movie file.
+ *
+ * @param out The file to write to.
+ * @param movie The movie.
+ * @param genre The genre code to write, which may be an unknown one.
+ * @param stock The number of copies in stock.
+ */
+void writeMovie(ostream &out, const Movie &movie, char genre, int stock) {
+  out << genre << ", " << stock << ", " << movie.director << ", " << movie.title << ", ";
+
+  if(movie.genre == 'C') {
+    out << movie.actor << ' ' << movie.month << ' ' << movie.year << '\n';
+
+  } else {
+      out << movie.year << '\n';
+  }
+}
+
+/**
+ * Writes a borrow or return command for a movie.
+ *
+ * @param out The file to write to.
+ * @param type 'B' or 'R'.
+ * @param customerID The customer borrowing or returning the movie.
+ * @param movie The movie.
+ * @param genre The genre code to write, which may be an unknown one.
+ */
+void writeBorrowOrReturn(ostream &out, char type, long long customerID,
+  const Movie &movie, char genre) {
+  out << type << ' ' << customerID << " D " << genre << ' ';
+
+  if(movie.genre == 'C') {
+    out << movie.month << ' ' << movie.year << ' ' << movie.actor << '\n';
+
+  } else if(movie.genre == 'D') {
+      out << movie.director << ", " << movie.title << ",\n";
+
+  } else {
+      out << movie.title << ", " << movie.year << '\n';
+  }
+}
+
+/**
+ * Builds the cumulative distribution of Zipfian popularity over ranks.
+ *
+ * @param count The number of ranks.
+ * @param exponent The Zipf exponent s.
+ * @return The cumulative probability of each rank, ending at 1.
+ */
+vector<double> zipfDistribution(size_t count, double exponent) {
+  vector<double> cumulative(count);
+  double total = 0.0;
+
+  for(size_t rank = 0; rank < count; rank++) {
+    total += 1.0 / pow(rank + 1.0, exponent);
+    cumulative[rank] = total;
+  }
+
+  for(double &value : cumulative) {
+    value /= total;
+  }
+
+  return cumulative;
+}
+
+/**
+ * Reads the value of an option, or reports that it is missing.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @param index The index of the option; advanced past its value.
+ * @param value Receives the value.
+ * @return true if the option has a value; false otherwise.
+ */
+bool optionValue(int argc, char *argv[], int &index, string &value) {
+  if(index + 1 >= argc) {
+    cout << "Error: " << argv[index] << " needs a value." << endl;
+    return false;
+  }
+
+  value = argv[++index];
+  return true;
+}
+
+/**
+ * Parses the options following the output directory.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @param options Receives the options.
+ * @return true if every option was understood; false otherwise.
+ */
+bool parseOptions(int argc, char *argv[], Options &options) {
+  for(int i = 2; i < argc; i++) {
+    string name = argv[i], value;
+
+    if(!optionValue(argc, argv, i, value)) {
+      return false;
+    }
+
+    if(name == "--movies") {
+      options.movies = atoll(value.c_str());
+
+    } else if(name == "--customers") {
+        options.customers = atoll(value.c_str());
+
+    } else if(name == "--commands") {
+        options.commands = atoll(value.c_str());
+
+    } else if(name == "--genres") {
+        if(sscanf(value.c_str(), "%lf:%lf:%lf", &options.genreShares[0],
+          &options.genreShares[1], &options.genreShares[2]) != 3) {
+          cout << "Error: --genres needs three shares, such as 2:1:1." << endl;
+          return false;
+        }
+
+    } else if(name == "--zipf") {
+        options.zipf = atof(value.c_str());
+
+    } else if(name == "--invalid-customer") {
+        options.invalidCustomer = atof(value.c_str());
+
+    } else if(name == "--invalid-genre") {
+        options.invalidGenre = atof(value.c_str());
+
+    } else if(name == "--history") {
+        options.history = atof(value.c_str());
+
+    } else if(name == "--inventory") {
+        options.inventory = atof(value.c_str());
+
+    } else if(name == "--returns") {
+        options.returns = atof(value.c_str());
+
+    } else if(name == "--stock") {
+        options.stock = atoi(value.c_str());
+
+    } else if(name == "--seed") {
+        options.seed = strtoull(value.c_str(), nullptr, 10);
+
+    } else {
+        cout << "Error: unknown option " << name << "." << endl;
+        return false;
+    }
+  }
+
+  double shareTotal = options.genreShares[0] + options.genreShares[1] + options.genreShares[2];
+
+  if(options.movies <= 0 || options.customers <= 0 || options.commands < 0
+    || shareTotal <= 0 || options.genreShares[0] < 0 || options.genreShares[1] < 0
+    || options.genreShares[2] < 0) {
+    cout << "Error: movies and customers must be positive, and some genre share must be." << endl;
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  Options options;
+
+  if(argc < 2 || !parseOptions(argc, argv, options)) {
+    cout << "Usage: " << argv[0] << " <output directory> [--movies n] [--customers n] "
+         << "[--commands n] [--genres C:D:F] [--zipf s] [--invalid-customer rate] "
+         << "[--invalid-genre rate] [--history rate] [--inventory rate] [--returns rate] "
+         << "[--stock n] [--seed n]" << endl;
+    return 1;
+  }
+
+  string directory = argv[1];
+  ofstream movieFile(directory + "/data4movies.txt");
+  ofstream customerFile(directory + "/data4customers.txt");
+  ofstream commandFile(directory + "/data4commands.txt");
+
+  if(!movieFile || !customerFile || !commandFile) {
+    cout << "Error: cannot create the files in " << directory << "." << endl;
+    return 1;
+  }
+
+  Random random(options.seed);
+  vector<Movie> movies = makeMovies(random, options);
+  const char unknownGenres[] = "ABEGXZ";
+
+  for(const Movie &movie : movies) {
+    char genre = random.unit() < options.invalidGenre ? unknownGenres[random.below(6)] : movie.genre;
+    writeMovie(movieFile, movie, genre, options.stock);
+  }
+
+  // Customer IDs start at 1000; commands for missing customers use IDs past the last one.
+  const long long firstID = 1000;
+  vector<string> names;
+  for(int i = 0; i < 3000; i++) {
+    names.push_back(makeWord(random));
+  }
+
+  for(long long i = 0; i < options.customers; i++) {
+    customerFile << firstID + i << ' ' << names[random.below(names.size())] << ' '
+                 << names[random.below(names.size())] << '\n';
+  }
+
+  // Popularity follows rank, and the ranks are shuffled across the movies.
+  vector<size_t> byRank(movies.size());
+  for(size_t i = 0; i < byRank.size(); i++) {
+    byRank[i] = i;
+  }
+
+  for(size_t i = byRank.size() - 1; i > 0; i--) {
+    swap(byRank[i], byRank[random.below(i + 1)]);
+  }
+
+  vector<double> popularity = zipfDistribution(movies.size(), options.zipf);
+
+  for(long long i = 0; i < options.commands; i++) {
+    long long customerID = random.unit() < options.invalidCustomer
+      ? firstID + options.customers + random.below(options.customers)
+      : firstID + random.below(options.customers);
+    double kind = random.unit();
+
+    if(kind < options.inventory) {
+      commandFile << "I\n";
+
+    } else if(kind < options.inventory + options.history) {
+        commandFile << "H " << customerID << '\n';
+
+    } else {
+        size_t rank = lower_bound(popularity.begin(), popularity.end(), random.unit())
+          - popularity.begin();
+        const Movie &movie = movies[byRank[min(rank, movies.size() - 1)]];
+        char genre = random.unit() < options.invalidGenre
+          ? unknownGenres[random.below(6)] : movie.genre;
+        writeBorrowOrReturn(commandFile, random.unit() < options.returns ? 'R' : 'B',
+          customerID, movie, genre);
+    }
+  }
+
+  movieFile.close();
+  customerFile.close();
+  commandFile.close();
+
+  if(!movieFile || !customerFile || !commandFile) {
+    cout << "Error: cannot write the files in " << directory << "." << endl;
+    return 1;
+  }
+
+  cout << "Wrote " << movies.size() << " movies, " << options.customers << " customers and "
+       << options.commands << " commands to " << directory << "." << endl;
+  return 0;
+}